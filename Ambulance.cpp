@@ -1,79 +1,874 @@
 #include "Ambulance.hpp"
+#include "AmbulanceTelemetry.hpp"
+#include "Instrumentation.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
 #include <limits>
+#include <sstream>
+
+// ---------------------------------------------------------------------------
+// AmbulanceGrid
+// ---------------------------------------------------------------------------
+
+AmbulanceGrid::AmbulanceGrid(double cellSizeKm)
+{
+    cellSize = cellSizeKm > 0 ? cellSizeKm : 1.0;
+    minCellX = minCellY = 0;
+    maxCellX = maxCellY = -1; // no cell used yet
+    boundsStale = false;
+    count = 0;
+}
+
+// Clamped, so a far-off query point (or NaN) never overflows the cast
+int AmbulanceGrid::cellCoord(double v) const
+{
+    double cell = floor(v / cellSize);
+    if (!(cell > -CELL_LIMIT))
+        return -CELL_LIMIT;
+    if (cell > CELL_LIMIT)
+        return CELL_LIMIT;
+    return (int)cell;
+}
+
+bool AmbulanceGrid::validPosition(double x, double y) const
+{
+    return std::isfinite(x) && std::isfinite(y) &&
+           fabs(x / cellSize) < CELL_LIMIT && fabs(y / cellSize) < CELL_LIMIT;
+}
+
+long long AmbulanceGrid::cellKey(int cx, int cy)
+{
+    return ((long long)cx << 32) ^ (long long)(unsigned int)cy;
+}
+
+void AmbulanceGrid::cellOf(long long key, int &cx, int &cy)
+{
+    cx = (int)(key >> 32);
+    cy = (int)(unsigned int)(key & 0xffffffffLL);
+}
+
+void AmbulanceGrid::place(Ambulance *unit)
+{
+    int cx = cellCoord(unit->x);
+    int cy = cellCoord(unit->y);
+    if (maxCellX < minCellX)
+    {
+        minCellX = maxCellX = cx;
+        minCellY = maxCellY = cy;
+    }
+    else
+    {
+        minCellX = min(minCellX, cx);
+        maxCellX = max(maxCellX, cx);
+        minCellY = min(minCellY, cy);
+        maxCellY = max(maxCellY, cy);
+    }
+
+    unit->gridCell = cellKey(cx, cy);
+    vector<Ambulance *> &cell = cells[unit->gridCell];
+    unit->gridSlot = (int)cell.size();
+    cell.push_back(unit);
+}
+
+void AmbulanceGrid::insert(Ambulance *unit)
+{
+    if (contains(unit))
+        return;
+    place(unit);
+    count++;
+}
+
+void AmbulanceGrid::remove(Ambulance *unit)
+{
+    if (!contains(unit))
+        return;
+
+    // Swap-remove inside the cell
+    vector<Ambulance *> &cell = cells[unit->gridCell];
+    Ambulance *last = cell.back();
+    cell[unit->gridSlot] = last;
+    last->gridSlot = unit->gridSlot;
+    cell.pop_back();
+    unit->gridSlot = -1;
+    count--;
+
+    if (cell.empty())
+    {
+        cells.erase(unit->gridCell);
+        int cx = cellCoord(unit->x);
+        int cy = cellCoord(unit->y);
+        if (count == 0)
+        {
+            minCellX = minCellY = 0;
+            maxCellX = maxCellY = -1;
+            boundsStale = false;
+        }
+        else if (cx == minCellX || cx == maxCellX || cy == minCellY || cy == maxCellY)
+        {
+            boundsStale = true;
+        }
+    }
+}
+
+void AmbulanceGrid::recomputeBounds() const
+{
+    bool first = true;
+    for (unordered_map<long long, vector<Ambulance *> >::const_iterator it = cells.begin(); it != cells.end(); ++it)
+    {
+        int cx, cy;
+        cellOf(it->first, cx, cy);
+        if (first)
+        {
+            minCellX = maxCellX = cx;
+            minCellY = maxCellY = cy;
+            first = false;
+            continue;
+        }
+        minCellX = min(minCellX, cx);
+        maxCellX = max(maxCellX, cx);
+        minCellY = min(minCellY, cy);
+        maxCellY = max(maxCellY, cy);
+    }
+    boundsStale = false;
+}
+
+void AmbulanceGrid::move(Ambulance *unit, double x, double y)
+{
+    if (contains(unit) && cellKey(cellCoord(x), cellCoord(y)) != unit->gridCell)
+    {
+        remove(unit);
+        unit->x = x;
+        unit->y = y;
+        insert(unit);
+        return;
+    }
+    unit->x = x;
+    unit->y = y;
+}
+
+vector<pair<double, Ambulance *> > AmbulanceGrid::nearest(double x, double y, int k) const
+{
+    vector<pair<double, Ambulance *> > best; // max-heap on distance, at most k entries
+    if (k <= 0 || count == 0 || !std::isfinite(x) || !std::isfinite(y))
+        return best;
+    k = min(k, count);
+    if (boundsStale)
+        recomputeBounds();
+
+    int qx = cellCoord(x);
+    int qy = cellCoord(y);
+    int maxRing = max(max(qx - minCellX, maxCellX - qx), max(qy - minCellY, maxCellY - qy));
+    // Rings that do not reach the bounding box hold no units
+    int firstRing = max(0, max(max(minCellX - qx, qx - maxCellX), max(minCellY - qy, qy - maxCellY)));
+    int visited = 0;
+
+    auto scanUnits = [&](const vector<Ambulance *> &cell)
+    {
+        visited += (int)cell.size();
+        for (size_t i = 0; i < cell.size(); i++)
+        {
+            double d = hypot(cell[i]->x - x, cell[i]->y - y);
+            if ((int)best.size() < k)
+            {
+                best.push_back(make_pair(d, cell[i]));
+                push_heap(best.begin(), best.end());
+            }
+            else if (d < best.front().first)
+            {
+                pop_heap(best.begin(), best.end());
+                best.back() = make_pair(d, cell[i]);
+                push_heap(best.begin(), best.end());
+            }
+        }
+    };
+    auto scanCell = [&](int cx, int cy)
+    {
+        unordered_map<long long, vector<Ambulance *> >::const_iterator it = cells.find(cellKey(cx, cy));
+        if (it != cells.end())
+            scanUnits(it->second);
+    };
+
+    for (int r = firstRing; r <= maxRing && visited < count; r++)
+    {
+        if (r > 0 && (int)best.size() == k)
+        {
+            // Closest any cell of ring r can be: the edge of the inner square
+            double bound = min(min(x - (qx - r + 1) * cellSize, (qx + r) * cellSize - x),
+                               min(y - (qy - r + 1) * cellSize, (qy + r) * cellSize - y));
+            if (best.front().first <= bound)
+                break;
+        }
+
+        // Sparse, spread-out fleet: once a ring costs more lookups than there
+        // are occupied cells, visit the cells outside the scanned square directly
+        if ((long long)8 * r > (long long)cells.size())
+        {
+            for (unordered_map<long long, vector<Ambulance *> >::const_iterator it = cells.begin(); it != cells.end(); ++it)
+            {
+                int cx, cy;
+                cellOf(it->first, cx, cy);
+                if (abs(cx - qx) >= r || abs(cy - qy) >= r)
+                    scanUnits(it->second);
+            }
+            break;
+        }
+
+        if (r == 0)
+        {
+            scanCell(qx, qy);
+            continue;
+        }
+
+        // Top and bottom rows, then the side columns without their corners
+        int fromX = max(qx - r, minCellX), toX = min(qx + r, maxCellX);
+        for (int side = -1; side <= 1; side += 2)
+        {
+            int cy = qy + side * r;
+            if (cy < minCellY || cy > maxCellY)
+                continue;
+            for (int cx = fromX; cx <= toX; cx++)
+                scanCell(cx, cy);
+        }
+        int fromY = max(qy - r + 1, minCellY), toY = min(qy + r - 1, maxCellY);
+        for (int side = -1; side <= 1; side += 2)
+        {
+            int cx = qx + side * r;
+            if (cx < minCellX || cx > maxCellX)
+                continue;
+            for (int cy = fromY; cy <= toY; cy++)
+                scanCell(cx, cy);
+        }
+    }
+
+    sort_heap(best.begin(), best.end());
+    return best;
+}
+
+// ---------------------------------------------------------------------------
+// ShiftRoster
+// ---------------------------------------------------------------------------
+
+ShiftRoster::ShiftRoster(size_t checkpointEveryEvents)
+{
+    checkpointEvery = checkpointEveryEvents > 0 ? checkpointEveryEvents : 64;
+    liveUnits = 0;
+    shiftSeconds = 8 * 3600;
+    shiftAnchor = 7 * 3600; // 07:00 UTC until setShiftSchedule is called
+}
+
+void ShiftRoster::setShiftSchedule(long long anchor, long long seconds)
+{
+    shiftAnchor = anchor;
+    shiftSeconds = seconds > 0 ? seconds : 8 * 3600;
+}
+
+void ShiftRoster::log(long long time, int type, int value)
+{
+    // The log must stay sorted by time; a clock step backwards is clamped
+    if (!events.empty() && time < events.back().time)
+        time = events.back().time;
+    RosterEvent e = { time, type, value };
+    events.push_back(e);
+}
+
+int ShiftRoster::registerUnit(const string &id, long long time)
+{
+    int unit = (int)unitNames.size();
+    unitNames.push_back(id);
+    liveUnits++;
+    log(time, ROSTER_REGISTER, unit);
+    return unit;
+}
+
+void ShiftRoster::removeUnit(int unit, long long time)
+{
+    liveUnits--;
+    log(time, ROSTER_REMOVE, unit);
+}
+
+void ShiftRoster::rotate(long long k, long long time)
+{
+    // Only k modulo the fleet size matters, and it always fits the event
+    if (liveUnits > 0)
+        k %= (long long)liveUnits;
+    if (k != 0)
+        log(time, ROSTER_ROTATE, (int)k);
+}
+
+bool ShiftRoster::checkpointDue() const
+{
+    size_t since = events.size() - (checkpoints.empty() ? 0 : checkpoints.back().eventCount);
+    return since >= max(checkpointEvery, liveUnits);
+}
+
+void ShiftRoster::checkpoint(const vector<int> &frontFirstOrder)
+{
+    if (events.empty())
+        return;
+    Checkpoint c;
+    c.time = events.back().time;
+    c.eventCount = events.size();
+    c.order = frontFirstOrder;
+    checkpoints.push_back(c);
+}
+
+// Same rules as the live ring: a new unit joins at the rear (just before the
+// front), removing the front makes the next unit the front
+void ShiftRoster::apply(vector<int> &order, size_t &offset, const RosterEvent &e)
+{
+    if (e.type == ROSTER_REGISTER)
+    {
+        if (offset == 0)
+        {
+            order.push_back(e.value);
+        }
+        else
+        {
+            order.insert(order.begin() + offset, e.value);
+            offset++;
+        }
+    }
+    else if (e.type == ROSTER_REMOVE)
+    {
+        size_t pos = find(order.begin(), order.end(), e.value) - order.begin();
+        if (pos == order.size())
+            return;
+        order.erase(order.begin() + pos);
+        if (pos < offset)
+            offset--;
+        if (offset >= order.size())
+            offset = 0;
+    }
+    else if (!order.empty())
+    {
+        long long n = (long long)order.size();
+        offset = (size_t)((((long long)offset + e.value) % n + n) % n);
+    }
+}
+
+const ShiftRoster::Checkpoint *ShiftRoster::lastCheckpointAt(long long t) const
+{
+    vector<Checkpoint>::const_iterator it =
+        upper_bound(checkpoints.begin(), checkpoints.end(), t,
+                    [](long long value, const Checkpoint &c) { return value < c.time; });
+    return it == checkpoints.begin() ? nullptr : &*(it - 1);
+}
+
+// Rotation as of time t (after every event logged at or before t), as an
+// unrotated unit list plus the index of the front
+void ShiftRoster::stateAt(long long t, vector<int> &order, size_t &offset) const
+{
+    order.clear();
+    offset = 0;
+    size_t next = 0;
+
+    const Checkpoint *base = lastCheckpointAt(t);
+    if (base != nullptr)
+    {
+        order = base->order;
+        next = base->eventCount;
+    }
+
+    for (; next < events.size() && events[next].time <= t; next++)
+        apply(order, offset, events[next]);
+}
+
+long long ShiftRoster::shiftsBetween(long long from, long long to) const
+{
+    if (to <= from)
+        return 0;
+    // floor division, so times before the anchor count correctly too
+    long long a = from - shiftAnchor, b = to - shiftAnchor;
+    long long fa = a >= 0 ? a / shiftSeconds : -((-a + shiftSeconds - 1) / shiftSeconds);
+    long long fb = b >= 0 ? b / shiftSeconds : -((-b + shiftSeconds - 1) / shiftSeconds);
+    return fb - fa;
+}
+
+int ShiftRoster::frontAt(long long t, long long now) const
+{
+    long long at = min(t, now);
+    long long turns = shiftsBetween(now, t);
+
+    // Only rotations since the checkpoint: index straight into it, no copy
+    const Checkpoint *base = lastCheckpointAt(at);
+    bool rotationsOnly = base != nullptr;
+    for (size_t i = base != nullptr ? base->eventCount : 0;
+         rotationsOnly && i < events.size() && events[i].time <= at; i++)
+    {
+        rotationsOnly = events[i].type == ROSTER_ROTATE;
+        turns += events[i].value;
+    }
+    if (rotationsOnly)
+    {
+        if (base->order.empty())
+            return -1;
+        long long n = (long long)base->order.size();
+        return base->order[(size_t)((turns % n + n) % n)];
+    }
+
+    vector<int> order;
+    size_t offset;
+    stateAt(min(t, now), order, offset);
+    if (order.empty())
+        return -1;
+    long long n = (long long)order.size();
+    return order[(size_t)(((long long)offset + shiftsBetween(now, t) % n) % n)];
+}
+
+vector<int> ShiftRoster::rosterAt(long long t, long long now) const
+{
+    vector<int> order;
+    size_t offset;
+    stateAt(min(t, now), order, offset);
+    if (order.empty())
+        return order;
+    long long n = (long long)order.size();
+    offset = (size_t)(((long long)offset + shiftsBetween(now, t) % n) % n);
+    std::rotate(order.begin(), order.begin() + offset, order.end());
+    return order;
+}
+
+// ---------------------------------------------------------------------------
+// AmbulanceQueue
+// ---------------------------------------------------------------------------
 
 AmbulanceQueue::AmbulanceQueue()
 {
-    front = nullptr;
-    rear = nullptr;
+    ringHead = 0;
+    ringSize = 0;
+    tombstones = 0;
+
+    // Shifts change at 07:00, 15:00 and 23:00 local time
+    tm anchor = {};
+    anchor.tm_year = 100;
+    anchor.tm_mday = 1;
+    anchor.tm_hour = 7;
+    anchor.tm_isdst = -1;
+    roster.setShiftSchedule((long long)mktime(&anchor), 8 * 3600);
+    for (int s = 0; s < STATUS_COUNT; s++)
+    {
+        statusHead[s] = statusTail[s] = nullptr;
+        statusCount[s] = 0;
+    }
 }
 
 AmbulanceQueue::~AmbulanceQueue()
 {
-    if (front == nullptr)
+    // records owns every unit
+}
+
+bool AmbulanceQueue::isEmpty()
+{
+    lock_guard<mutex> guard(fleetLock);
+    return ringSize == tombstones;
+}
+
+int AmbulanceQueue::size() const
+{
+    lock_guard<mutex> guard(fleetLock);
+    return (int)(ringSize - tombstones);
+}
+
+void AmbulanceQueue::placeInRing(Ambulance *unit, size_t slot)
+{
+    ring[slot] = unit;
+    unit->ringSlot = slot;
+}
+
+void AmbulanceQueue::rebuildRing(size_t capacity)
+{
+    vector<Ambulance *> packed(capacity, nullptr);
+    size_t live = 0;
+    for (size_t i = 0; i < ringSize; i++)
+    {
+        Ambulance *unit = slotAt(i);
+        if (unit != nullptr)
+        {
+            packed[live] = unit;
+            unit->ringSlot = live;
+            live++;
+        }
+    }
+    ring.swap(packed);
+    ringHead = 0;
+    ringSize = live;
+    tombstones = 0;
+}
+
+void AmbulanceQueue::pushRotation(Ambulance *unit)
+{
+    if (ringSize == ring.size())
+    {
+        // Full: squeeze out tombstones, or unroll into a buffer twice the size
+        rebuildRing(ring.empty() ? 16 : (tombstones > 0 ? ring.size() : ring.size() * 2));
+    }
+    placeInRing(unit, (ringHead + ringSize) & (ring.size() - 1));
+    ringSize++;
+}
+
+void AmbulanceQueue::checkpointRoster()
+{
+    if (!roster.checkpointDue())
         return;
+    vector<int> order;
+    order.reserve(ringSize - tombstones);
+    visitRotation([&order](const Ambulance &unit) { order.push_back(unit.rosterUnit); });
+    roster.checkpoint(order);
+}
 
-    Ambulance *temp = front;
-    do
+void AmbulanceQueue::trimRing()
+{
+    while (ringSize > 0 && ring[ringHead] == nullptr)
+    {
+        ringHead = (ringHead + 1) & (ring.size() - 1);
+        ringSize--;
+        tombstones--;
+    }
+    while (ringSize > 0 && slotAt(ringSize - 1) == nullptr)
     {
-        Ambulance *del = temp;
-        temp = temp->next;
-        delete del;
-    } while (temp != front);
+        ringSize--;
+        tombstones--;
+    }
+    if (ringSize == 0)
+        ringHead = 0;
 }
 
-bool AmbulanceQueue::isEmpty()
+Ambulance *AmbulanceQueue::findAmbulance(const string &id)
 {
-    return front == nullptr;
+    unordered_map<string, Ambulance *>::iterator it = byID.find(id);
+    return it == byID.end() ? nullptr : it->second;
 }
 
-void AmbulanceQueue::registerAmbulance()
+void AmbulanceQueue::linkStatus(Ambulance *unit)
+{
+    int s = unit->status;
+    unit->statusPrev = statusTail[s];
+    unit->statusNext = nullptr;
+    if (statusTail[s] != nullptr)
+        statusTail[s]->statusNext = unit;
+    else
+        statusHead[s] = unit;
+    statusTail[s] = unit;
+    statusCount[s]++;
+}
+
+void AmbulanceQueue::unlinkStatus(Ambulance *unit)
+{
+    int s = unit->status;
+    if (unit->statusPrev != nullptr)
+        unit->statusPrev->statusNext = unit->statusNext;
+    else
+        statusHead[s] = unit->statusNext;
+    if (unit->statusNext != nullptr)
+        unit->statusNext->statusPrev = unit->statusPrev;
+    else
+        statusTail[s] = unit->statusPrev;
+    unit->statusPrev = unit->statusNext = nullptr;
+    statusCount[s]--;
+}
+
+void AmbulanceQueue::setStatus(Ambulance *unit, AmbulanceStatus status)
+{
+    bool wasAvailable = unit->status == STATUS_AVAILABLE;
+    unlinkStatus(unit);
+    unit->status = status;
+    linkStatus(unit);
+
+    // Only Available units with a known position are on the map
+    if (wasAvailable && status != STATUS_AVAILABLE)
+        availableGrid.remove(unit);
+    else if (!wasAvailable && status == STATUS_AVAILABLE && unit->hasPosition)
+        availableGrid.insert(unit);
+}
+
+string AmbulanceQueue::statusName(AmbulanceStatus status)
+{
+    switch (status)
+    {
+    case STATUS_AVAILABLE:
+        return "Available";
+    case STATUS_ON_DUTY:
+        return "OnDuty";
+    case STATUS_MAINTENANCE:
+        return "Maintenance";
+    default:
+        return "Unknown";
+    }
+}
+
+// Accepts the status names in any case, with or without spaces ("on duty")
+bool AmbulanceQueue::parseStatus(string text, AmbulanceStatus &status)
 {
-    Ambulance *newNode = new Ambulance;
+    string key;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (!isspace((unsigned char)text[i]))
+            key += (char)tolower((unsigned char)text[i]);
+    }
 
+    for (int s = 0; s < STATUS_COUNT; s++)
+    {
+        string name = statusName((AmbulanceStatus)s);
+        for (size_t i = 0; i < name.size(); i++)
+            name[i] = (char)tolower((unsigned char)name[i]);
+        if (key == name)
+        {
+            status = (AmbulanceStatus)s;
+            return true;
+        }
+    }
+    return false;
+}
+
+int AmbulanceQueue::countByStatus(AmbulanceStatus status) const
+{
+    lock_guard<mutex> guard(fleetLock);
+    return statusCount[status];
+}
+
+OpStatus AmbulanceQueue::getUnit(const string &id, Ambulance &copy) const
+{
+    lock_guard<mutex> guard(fleetLock);
+    unordered_map<string, Ambulance *>::const_iterator it = byID.find(id);
+    if (it == byID.end())
+        return OP_NOT_FOUND;
+    copy = *it->second;
+    return OP_OK;
+}
+
+void AmbulanceQueue::registerAmbulance()
+{
+    string id;
     cout << "Enter Ambulance ID: ";
-    cin >> newNode->id;
+    cin >> id;
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
+    bool taken;
+    {
+        lock_guard<mutex> guard(fleetLock);
+        taken = findAmbulance(id) != nullptr;
+    }
+    if (taken)
+    {
+        cout << "Ambulance ID " << id << " is already registered.\n";
+        return;
+    }
+
+    string driverName;
     cout << "Enter Driver Name: ";
-    getline(cin, newNode->driverName);
+    getline(cin, driverName);
+
+    OpStatus result = addAmbulance(id, driverName);
+    if (result == OP_DUPLICATE)
+        cout << "Ambulance ID " << id << " is already registered.\n";
+    else if (result != OP_OK)
+        cout << "Ambulance ID is required.\n";
+    else
+        cout << "Ambulance registered successfully!\n";
+}
 
-    newNode->status = "Available";
-    newNode->next = nullptr;
+OpStatus AmbulanceQueue::addAmbulance(const string &id, const string &driverName)
+{
+    if (id.empty())
+        return OP_INVALID_ARGUMENT; // a blank driver name is allowed, as at the prompt
+    lock_guard<mutex> guard(fleetLock);
+    if (findAmbulance(id) != nullptr)
+        return OP_DUPLICATE;
 
-    // first ambulance
-    if (isEmpty())
+    Ambulance *newNode;
+    if (!freeRecords.empty())
     {
-        front = rear = newNode;
-        rear->next = front; // make circular
+        newNode = freeRecords.back();
+        freeRecords.pop_back();
     }
     else
     {
-        rear->next = newNode;
-        rear = newNode;
-        rear->next = front;
+        records.push_back(Ambulance());
+        newNode = &records.back();
     }
+    newNode->id = id;
+    newNode->driverName = driverName;
+    newNode->status = STATUS_AVAILABLE;
+    newNode->statusPrev = newNode->statusNext = nullptr;
+    newNode->ringSlot = 0;
+    newNode->x = newNode->y = 0;
+    newNode->hasPosition = false;
+    newNode->gridCell = 0;
+    newNode->gridSlot = -1;
+    linkStatus(newNode);
 
-    cout << "Ambulance registered successfully!\n";
+    pushRotation(newNode);
+    byID[id] = newNode;
+    newNode->rosterUnit = roster.registerUnit(id, (long long)time(0));
+    checkpointRoster();
+    return OP_OK;
 }
 
-void AmbulanceQueue::rotateShift()
+OpStatus AmbulanceQueue::removeAmbulance(const string &id)
+{
+    lock_guard<mutex> guard(fleetLock);
+    Ambulance *unit = findAmbulance(id);
+    if (unit == nullptr)
+        return OP_NOT_FOUND;
+    eraseUnit(unit);
+    return OP_OK;
+}
+
+void AmbulanceQueue::eraseUnit(Ambulance *unit)
+{
+    byID.erase(unit->id);
+
+    unlinkStatus(unit);
+    availableGrid.remove(unit);
+
+    ring[unit->ringSlot] = nullptr;
+    tombstones++;
+    trimRing();
+    if (tombstones > 16 && tombstones > ringSize - tombstones)
+        rebuildRing(ring.size());
+
+    roster.removeUnit(unit->rosterUnit, (long long)time(0));
+    checkpointRoster();
+    freeRecords.push_back(unit);
+}
+
+void AmbulanceQueue::decommissionAmbulance()
 {
     if (isEmpty())
     {
-        cout << "No ambulances to rotate.\n";
+        cout << "No ambulances in the system.\n";
         return;
     }
 
-    // Moving front ambulance to the back in circular list
-    front = front->next;
-    rear = rear->next;
+    string id;
+    cout << "Enter Ambulance ID to decommission: ";
+    cin >> id;
+
+    string driverName;
+    {
+        lock_guard<mutex> guard(fleetLock);
+        Ambulance *unit = findAmbulance(id);
+        if (unit == nullptr)
+        {
+            cout << "Ambulance ID not found.\n";
+            return;
+        }
+        if (unit->status == STATUS_ON_DUTY)
+        {
+            cout << "Ambulance " << id << " is on duty. Recall it before decommissioning.\n";
+            return;
+        }
+        driverName = unit->driverName;
+        eraseUnit(unit);
+    }
+    cout << "Ambulance " << id << " (driver: " << driverName << ") removed from the rotation.\n";
+    cout << "Units in service: " << size() << endl;
+}
 
+void AmbulanceQueue::rotateShift()
+{
+    string newFrontID;
+    if (rotateOnce(newFrontID) != OP_OK)
+    {
+        cout << "No ambulances to rotate.\n";
+        return;
+    }
     cout << "Ambulance shift rotated successfully!\n";
 }
 
+OpStatus AmbulanceQueue::rotateOnce(string &newFrontID)
+{
+    lock_guard<mutex> guard(fleetLock);
+    if (ringSize == tombstones)
+        return OP_EMPTY;
+
+    // Moving front ambulance to the back: copy its handle into the slot after
+    // the rear, then advance the head (a no-op copy when the ring is full)
+    Ambulance *moved = ring[ringHead];
+    placeInRing(moved, (ringHead + ringSize) & (ring.size() - 1));
+    ringHead = (ringHead + 1) & (ring.size() - 1);
+    trimRing(); // an interior tombstone may now be at the front
+    roster.rotate(1, (long long)time(0));
+    checkpointRoster();
+
+    // ...and to the back of its status list
+    unlinkStatus(moved);
+    linkStatus(moved);
+    newFrontID = ring[ringHead]->id;
+    return OP_OK;
+}
+
+OpStatus AmbulanceQueue::rotateBy(long long k)
+{
+    lock_guard<mutex> guard(fleetLock);
+    if (k < 0)
+        return OP_INVALID_ARGUMENT;
+    if (ringSize == tombstones)
+        return OP_EMPTY;
+    rotateRing(k);
+    return OP_OK;
+}
+
+// Same end state as k calls to rotateOnce. The front (k mod n) handles are
+// copied past the rear, or the rest copied in front of the head, whichever is
+// fewer, and the head moves once. Status lists follow: each moved unit goes to
+// the back of its list, and after a full cycle every list is in ring order.
+void AmbulanceQueue::rotateRing(long long k)
+{
+    if (tombstones > 0)
+        rebuildRing(ring.size()); // packed, so the front units are the first slots
+    size_t live = ringSize;
+    size_t steps = (size_t)(k % (long long)live);
+    size_t mask = ring.size() - 1;
+
+    if (k < (long long)live)
+    {
+        for (size_t i = 0; i < steps; i++)
+        {
+            unlinkStatus(slotAt(i));
+            linkStatus(slotAt(i));
+        }
+    }
+
+    // A full ring only needs the head moved. Copying in this order never
+    // overwrites a handle that has not been copied yet.
+    if (steps <= live - steps)
+    {
+        for (size_t i = 0; live < ring.size() && i < steps; i++)
+            placeInRing(slotAt(i), (ringHead + live + i) & mask);
+        ringHead = (ringHead + steps) & mask;
+    }
+    else
+    {
+        size_t back = live - steps;
+        for (size_t i = 0; live < ring.size() && i < back; i++)
+            placeInRing(slotAt(live - 1 - i), (ringHead + ring.size() - 1 - i) & mask);
+        ringHead = (ringHead + ring.size() - back) & mask;
+    }
+
+    if (k >= (long long)live)
+    {
+        for (size_t i = 0; i < live; i++)
+        {
+            unlinkStatus(slotAt(i));
+            linkStatus(slotAt(i));
+        }
+    }
+
+    roster.rotate(k, (long long)time(0));
+    checkpointRoster();
+}
+
 void AmbulanceQueue::displaySchedule()
 {
-    if (isEmpty())
+    lock_guard<mutex> guard(fleetLock);
+    if (ringSize == tombstones)
     {
         cout << "No ambulances in the schedule.\n";
         return;
@@ -84,18 +879,19 @@ void AmbulanceQueue::displaySchedule()
     cout << "ID\tDriver Name\tStatus\n";
     cout << "========================================\n";
 
-    Ambulance *temp = front;
-
-    do
+    for (size_t i = 0; i < ringSize; i++)
     {
+        const Ambulance *temp = slotAt(i);
+        if (temp == nullptr)
+            continue;
         cout << temp->id << "\t" << temp->driverName
-             << "\t\t" << temp->status << endl;
-
-        temp = temp->next;
-
-    } while (temp != front);
+             << "\t\t" << statusName(temp->status) << endl;
+    }
 
     cout << "========================================\n";
+    cout << "Available: " << statusCount[STATUS_AVAILABLE]
+         << "  OnDuty: " << statusCount[STATUS_ON_DUTY]
+         << "  Maintenance: " << statusCount[STATUS_MAINTENANCE] << endl;
 }
 
 void AmbulanceQueue::updateStatus()
@@ -110,26 +906,34 @@ void AmbulanceQueue::updateStatus()
     cout << "Enter Ambulance ID to update: ";
     cin >> targetID;
 
-    Ambulance *temp = front;
-    bool found = false;
-
-    do
     {
-        if (temp->id == targetID)
+        lock_guard<mutex> guard(fleetLock);
+        Ambulance *temp = findAmbulance(targetID);
+        if (temp == nullptr)
         {
-            found = true;
-            cout << "Current Status: " << temp->status << endl;
-            cout << "Enter New Status (Available / OnDuty / Maintenance): ";
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            getline(cin, temp->status);
-            cout << "Status updated successfully!\n";
-            break;
+            cout << "Ambulance ID not found.\n";
+            return;
         }
-        temp = temp->next;
-    } while (temp != front);
+        cout << "Current Status: " << statusName(temp->status) << endl;
+    }
 
-    if (!found)
+    cout << "Enter New Status (Available / OnDuty / Maintenance): ";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string text;
+    getline(cin, text);
+
+    AmbulanceStatus status;
+    if (!parseStatus(text, status))
+    {
+        cout << "Unknown status \"" << text << "\". Status not changed.\n";
+        return;
+    }
+    if (setStatus(targetID, status) != OP_OK)
+    {
         cout << "Ambulance ID not found.\n";
+        return;
+    }
+    cout << "Status updated successfully!\n";
 }
 
 void AmbulanceQueue::searchAmbulance()
@@ -144,27 +948,339 @@ void AmbulanceQueue::searchAmbulance()
     cout << "Enter Ambulance ID to search: ";
     cin >> keyword;
 
-    Ambulance *temp = front;
-    bool found = false;
+    lock_guard<mutex> guard(fleetLock);
+    Ambulance *temp = findAmbulance(keyword);
+    if (temp == nullptr)
+    {
+        cout << "Ambulance not found.\n";
+        return;
+    }
 
-    do
+    cout << "\nAmbulance Found:\n";
+    cout << "--------------------------------\n";
+    cout << "ID: " << temp->id << endl;
+    cout << "Driver Name: " << temp->driverName << endl;
+    cout << "Status: " << statusName(temp->status) << endl;
+    if (temp->hasPosition)
+        cout << "Position: (" << temp->x << ", " << temp->y << ")\n";
+    else
+        cout << "Position: unknown\n";
+    cout << "--------------------------------\n";
+}
+
+void AmbulanceQueue::dispatchNextAvailable()
+{
+    string id, driverName;
+    if (reserveNextAvailable(id, driverName) != OP_OK)
+    {
+        cout << "No ambulance is available for dispatch.\n";
+        return;
+    }
+
+    cout << "Dispatched ambulance " << id << " (driver: " << driverName << ").\n";
+    cout << "Units still available: " << countByStatus(STATUS_AVAILABLE) << endl;
+}
+
+// Head of the Available list goes OnDuty; lookup and status flip happen
+// under one lock, so two dispatchers never get the same unit
+OpStatus AmbulanceQueue::reserveNextAvailable(string &id, string &driverName)
+{
+    lock_guard<mutex> guard(fleetLock);
+    Ambulance *unit = statusHead[STATUS_AVAILABLE];
+    if (unit == nullptr)
+        return OP_UNAVAILABLE;
+
+    setStatus(unit, STATUS_ON_DUTY);
+    id = unit->id;
+    driverName = unit->driverName;
+    return OP_OK;
+}
+
+OpStatus AmbulanceQueue::setPosition(const string &id, double x, double y)
+{
+    lock_guard<mutex> guard(fleetLock);
+    return applyPosition(id, x, y);
+}
+
+OpStatus AmbulanceQueue::applyPosition(const string &id, double x, double y)
+{
+    Ambulance *unit = findAmbulance(id);
+    if (unit == nullptr)
+        return OP_NOT_FOUND;
+    if (!availableGrid.validPosition(x, y))
+        return OP_INVALID_ARGUMENT;
+
+    availableGrid.move(unit, x, y);
+    unit->hasPosition = true;
+    if (unit->status == STATUS_AVAILABLE)
+        availableGrid.insert(unit); // no-op if already on the map
+    return OP_OK;
+}
+
+OpStatus AmbulanceQueue::setStatus(const string &id, AmbulanceStatus status)
+{
+    HOSPITAL_TIMED(METRIC_SET_STATUS);
+    lock_guard<mutex> guard(fleetLock);
+    return applyStatus(id, status);
+}
+
+OpStatus AmbulanceQueue::applyStatus(const string &id, AmbulanceStatus status)
+{
+    Ambulance *unit = findAmbulance(id);
+    if (unit == nullptr)
+        return OP_NOT_FOUND;
+    if (unit->status != status)
+        setStatus(unit, status);
+    return OP_OK;
+}
+
+void AmbulanceQueue::applyTelemetry(const TelemetryUpdate *updates, size_t count, OpStatus *results)
+{
+    lock_guard<mutex> guard(fleetLock);
+    string id;
+    for (size_t i = 0; i < count; i++)
     {
-        if (temp->id == keyword)
+        const TelemetryUpdate &u = updates[i];
+        id.assign(u.id);
+        if (u.kind == TELEMETRY_POSITION)
         {
-            found = true;
-            cout << "\nAmbulance Found:\n";
-            cout << "--------------------------------\n";
-            cout << "ID: " << temp->id << endl;
-            cout << "Driver Name: " << temp->driverName << endl;
-            cout << "Status: " << temp->status << endl;
-            cout << "--------------------------------\n";
-            break;
+            results[i] = applyPosition(id, u.x, u.y);
+        }
+        else
+        {
+            HOSPITAL_TIMED(METRIC_SET_STATUS);
+            results[i] = applyStatus(id, u.status);
         }
-        temp = temp->next;
-    } while (temp != front);
+    }
+}
 
-    if (!found)
-        cout << "Ambulance not found.\n";
+vector<NearbyUnit> AmbulanceQueue::nearestAvailable(double x, double y, int k) const
+{
+    lock_guard<mutex> guard(fleetLock);
+    vector<pair<double, Ambulance *> > units = availableGrid.nearest(x, y, k);
+
+    // Copy out while the lock is held; the units may move or be removed after
+    vector<NearbyUnit> found(units.size());
+    for (size_t i = 0; i < units.size(); i++)
+    {
+        found[i].id = units[i].second->id;
+        found[i].driverName = units[i].second->driverName;
+        found[i].x = units[i].second->x;
+        found[i].y = units[i].second->y;
+        found[i].distance = units[i].first;
+    }
+    return found;
+}
+
+// Position file: one "ID X Y" per line (km on the local grid), as written by
+// a GPS export or the fleet simulator. Blank lines and '#' comments are skipped.
+int AmbulanceQueue::loadPositions(const string &fileName, int &skipped)
+{
+    ifstream file(fileName.c_str());
+    if (!file)
+        return -1;
+
+    int updated = 0;
+    skipped = 0;
+    string line;
+    while (getline(file, line))
+    {
+        if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == string::npos)
+            continue;
+
+        istringstream fields(line);
+        string id;
+        double x, y;
+        if (fields >> id >> x >> y && setPosition(id, x, y) == OP_OK)
+            updated++;
+        else
+            skipped++;
+    }
+    return updated;
+}
+
+void AmbulanceQueue::loadPositionsFromFile()
+{
+    string fileName;
+    cout << "Enter position file path: ";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    getline(cin, fileName);
+
+    int skipped = 0;
+    int updated = loadPositions(fileName, skipped);
+    if (updated < 0)
+    {
+        cout << "Cannot open file: " << fileName << endl;
+        return;
+    }
+
+    cout << updated << " position(s) updated";
+    if (skipped > 0)
+        cout << ", " << skipped << " line(s) skipped (unknown ID or bad format)";
+    lock_guard<mutex> guard(fleetLock);
+    cout << ".\nAvailable units on the map: " << availableGrid.size() << endl;
+}
+
+void AmbulanceQueue::dispatchNearest()
+{
+    bool noneOnMap;
+    {
+        lock_guard<mutex> guard(fleetLock);
+        noneOnMap = availableGrid.size() == 0;
+    }
+    if (noneOnMap)
+    {
+        cout << "No Available ambulance has a known position.\n";
+        return;
+    }
+
+    double x, y;
+    int k;
+    cout << "Enter incident position (X Y): ";
+    cin >> x >> y;
+    cout << "How many nearest units to list: ";
+    cin >> k;
+    if (!cin || k < 1)
+    {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Invalid input.\n";
+        return;
+    }
+
+    vector<NearbyUnit> units = nearestAvailable(x, y, k);
+    if (units.empty())
+    {
+        cout << "No Available ambulance has a known position.\n";
+        return;
+    }
+    cout << "\nNearest Available Ambulances:\n";
+    cout << "========================================\n";
+    cout << "#\tID\tDriver Name\tDistance (km)\n";
+    cout << "========================================\n";
+    for (size_t i = 0; i < units.size(); i++)
+    {
+        cout << (i + 1) << "\t" << units[i].id << "\t" << units[i].driverName
+             << "\t\t" << fixed << setprecision(2) << units[i].distance << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cout << "========================================\n";
+    string nearestID = units[0].id;
+
+    char confirm;
+    cout << "Dispatch " << nearestID << "? (Y/N): ";
+    cin >> confirm;
+    if (confirm == 'Y' || confirm == 'y')
+    {
+        // The unit may have been auto-dispatched while we waited for input
+        lock_guard<mutex> guard(fleetLock);
+        Ambulance *unit = findAmbulance(nearestID);
+        if (unit == nullptr || unit->status != STATUS_AVAILABLE)
+        {
+            cout << "Ambulance " << nearestID << " is no longer available.\n";
+            return;
+        }
+        setStatus(unit, STATUS_ON_DUTY);
+        cout << "Dispatched ambulance " << nearestID << ".\n";
+    }
+}
+
+void AmbulanceQueue::replayTelemetry()
+{
+    string fileName;
+    cout << "Enter telemetry replay file path: ";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    getline(cin, fileName);
+
+    AmbulanceTelemetry telemetry;
+    if (!telemetry.startReplay(fileName))
+    {
+        cout << "Cannot open file: " << fileName << endl;
+        return;
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    while (!telemetry.finished())
+    {
+        if (telemetry.applyPending(*this) == 0)
+            this_thread::yield();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    telemetry.stop();
+
+    TelemetryStats stats = telemetry.getStats();
+    cout << "\nTelemetry Replay Summary:\n";
+    cout << "--------------------------------\n";
+    cout << "Updates received: " << stats.received << endl;
+    cout << "Applied: " << stats.applied << endl;
+    cout << "Unknown ambulance ID: " << stats.unknownUnit << endl;
+    cout << "Malformed lines: " << stats.malformed << endl;
+    cout << "Dropped (queue full): " << stats.dropped << endl;
+    cout << "Max queue depth: " << stats.maxDepth << " / " << stats.capacity << endl;
+    cout << "Batches: " << stats.batches << endl;
+    if (seconds > 0)
+        cout << "Rate: " << (long long)(stats.received / seconds) << " updates/s\n";
+    cout << "--------------------------------\n";
+}
+
+void AmbulanceQueue::viewRosterAt()
+{
+    bool noHistory;
+    {
+        lock_guard<mutex> guard(fleetLock);
+        noHistory = roster.eventCount() == 0;
+    }
+    if (noHistory)
+    {
+        cout << "No ambulances have been registered yet.\n";
+        return;
+    }
+
+    string text;
+    cout << "Enter date and time (YYYY-MM-DD HH:MM): ";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    getline(cin, text);
+
+    tm when = {};
+    if (sscanf(text.c_str(), "%d-%d-%d %d:%d", &when.tm_year, &when.tm_mon, &when.tm_mday,
+               &when.tm_hour, &when.tm_min) != 5)
+    {
+        cout << "Invalid date/time format.\n";
+        return;
+    }
+    when.tm_year -= 1900;
+    when.tm_mon -= 1;
+    when.tm_isdst = -1;
+    long long t = (long long)mktime(&when);
+    long long now = (long long)time(0);
+
+    lock_guard<mutex> guard(fleetLock);
+    vector<int> order = roster.rosterAt(t, now);
+    cout << "\nRoster at " << text;
+    if (t > now)
+        cout << " (projected: " << roster.shiftsBetween(now, t) << " shift change(s) from now, one every "
+             << roster.getShiftSeconds() / 3600 << " h)";
+    cout << "\n";
+    if (order.empty())
+    {
+        cout << "No ambulances were registered at that time.\n";
+        return;
+    }
+
+    cout << "========================================\n";
+    cout << "#\tID\tDriver Name\n";
+    cout << "========================================\n";
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const string &id = roster.unitName(order[i]);
+        Ambulance *unit = findAmbulance(id);
+        cout << (i + 1) << "\t" << id << "\t"
+             << (unit != nullptr && unit->rosterUnit == order[i] ? unit->driverName : "(decommissioned)");
+        if (i == 0)
+            cout << "\t<- on shift";
+        cout << endl;
+    }
+    cout << "========================================\n";
 }
 
 void AmbulanceQueue::menu()
@@ -179,6 +1295,12 @@ void AmbulanceQueue::menu()
         cout << "3. Display Ambulance Schedule\n";
         cout << "4. Update Ambulance Status\n";
         cout << "5. Search Ambulance by ID\n";
+        cout << "6. Dispatch Next Available Ambulance\n";
+        cout << "7. Load Ambulance Positions from File\n";
+        cout << "8. Dispatch Nearest Ambulance to Incident\n";
+        cout << "9. Replay Telemetry File\n";
+        cout << "10. Decommission Ambulance\n";
+        cout << "11. View Roster at Date/Time\n";
         cout << "0. Back to Main Menu\n";
         cout << "=============================================\n";
         cout << "Enter choice: ";
@@ -206,6 +1328,30 @@ void AmbulanceQueue::menu()
             searchAmbulance();
             break;
 
+        case 6:
+            dispatchNextAvailable();
+            break;
+
+        case 7:
+            loadPositionsFromFile();
+            break;
+
+        case 8:
+            dispatchNearest();
+            break;
+
+        case 9:
+            replayTelemetry();
+            break;
+
+        case 10:
+            decommissionAmbulance();
+            break;
+
+        case 11:
+            viewRosterAt();
+            break;
+
         case 0:
             cout << "Returning to Main Menu...\n";
             break;
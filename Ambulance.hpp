@@ -1,37 +1,270 @@
 #ifndef AMBULANCE_HPP
 #define AMBULANCE_HPP
 
+#include "OpStatus.hpp"
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 using namespace std;
 
+struct TelemetryUpdate; // AmbulanceTelemetry.hpp
+
+// ambulance status, also the index of its per-status list
+enum AmbulanceStatus
+{
+    STATUS_AVAILABLE = 0,
+    STATUS_ON_DUTY,
+    STATUS_MAINTENANCE,
+    STATUS_COUNT
+};
+
 // ambulance struct
 struct Ambulance
 {
     string id; //make it string to accommodate alphanumeric IDs
     std::string driverName;
-    std::string status;
-    Ambulance* next;
+    AmbulanceStatus status;
+    Ambulance* statusPrev; // per-status list (intrusive, doubly linked)
+    Ambulance* statusNext;
+    double x, y;           // last known position (km, local grid)
+    bool hasPosition;
+    long long gridCell;    // cell in the Available index, if indexed
+    int gridSlot;          // index inside that cell, -1 when not indexed
+    size_t ringSlot;       // physical slot in the rotation buffer
+    int rosterUnit;        // unit number in the shift roster
+};
+
+// Copy of an Available unit found by a nearest-unit query; safe to keep
+// after the fleet lock is released
+struct NearbyUnit
+{
+    string id;
+    string driverName;
+    double x, y;
+    double distance;
+};
+
+// Uniform grid over Available units with a known position.
+// Insert, remove and move are O(1) (swap-remove inside a cell); k-nearest
+// searches rings of cells outward from the query and stops once no closer
+// unit can exist or every unit has been seen. Only non-empty cells are kept,
+// and the bounds shrink back (lazily, on the next query) when an edge cell
+// empties, so one unit that passed far away does not widen every search.
+class AmbulanceGrid
+{
+private:
+    static const int CELL_LIMIT = 1 << 29; // |cell coordinate| cap, keeps ring maths in int
+
+    double cellSize;
+    unordered_map<long long, vector<Ambulance*> > cells;
+    mutable int minCellX, maxCellX, minCellY, maxCellY; // bounds of the non-empty cells
+    mutable bool boundsStale;
+    int count;
+
+    int cellCoord(double v) const;
+    static long long cellKey(int cx, int cy);
+    static void cellOf(long long key, int& cx, int& cy);
+    void place(Ambulance* unit);
+    void recomputeBounds() const;
+
+public:
+    explicit AmbulanceGrid(double cellSizeKm = 2.0);
+
+    void insert(Ambulance* unit);
+    void remove(Ambulance* unit);
+    void move(Ambulance* unit, double x, double y);
+    bool contains(const Ambulance* unit) const { return unit->gridSlot != -1; }
+
+    // Finite and within the grid's addressable range
+    bool validPosition(double x, double y) const;
+
+    // Up to k units ordered by distance, as (distance, unit)
+    vector<pair<double, Ambulance*> > nearest(double x, double y, int k) const;
+
+    int size() const { return count; }
+};
+
+enum RosterEventType
+{
+    ROSTER_REGISTER = 0,
+    ROSTER_REMOVE,
+    ROSTER_ROTATE
+};
+
+struct RosterEvent
+{
+    long long time; // seconds since the epoch
+    int type;       // RosterEventType
+    int value;      // unit number, or k for ROSTER_ROTATE
+};
+
+// Shift timeline of the rotation: every registration, removal and rotation
+// is logged with its time (16 bytes per event, O(1) append; rotating by k is
+// one event). The owner hands in the full rotation order whenever
+// checkpointDue() says so, i.e. after max(checkpointEvery, live units)
+// events, which keeps checkpoints at about one int per logged event.
+//
+// A point-in-time query binary-searches the checkpoints (O(log C)) and
+// replays only the events after the one it finds. Rotations replay in O(1);
+// a registration or removal in the window moves the unit list once. Times
+// after `now` are projected: one rotation per shift boundary.
+class ShiftRoster
+{
+private:
+    struct Checkpoint
+    {
+        long long time;    // time of the last event included
+        size_t eventCount; // events included
+        vector<int> order; // unit numbers, front first
+    };
+
+    vector<string> unitNames; // unit number -> ambulance ID
+    vector<RosterEvent> events;
+    vector<Checkpoint> checkpoints;
+    size_t checkpointEvery;
+    size_t liveUnits;
+    long long shiftSeconds;
+    long long shiftAnchor; // any time at which a shift starts
+
+    void log(long long time, int type, int value);
+    const Checkpoint* lastCheckpointAt(long long t) const; // nullptr if none
+    static void apply(vector<int>& order, size_t& offset, const RosterEvent& e);
+    void stateAt(long long t, vector<int>& order, size_t& offset) const;
+
+public:
+    explicit ShiftRoster(size_t checkpointEveryEvents = 64);
+
+    void setShiftSchedule(long long anchor, long long seconds);
+    int registerUnit(const string& id, long long time); // returns the unit number
+    void removeUnit(int unit, long long time);
+    void rotate(long long k, long long time);
+
+    bool checkpointDue() const;
+    void checkpoint(const vector<int>& frontFirstOrder); // state after the last event
+
+    // Unit on shift at time t (-1 if none), and the whole rotation, front first
+    int frontAt(long long t, long long now) const;
+    vector<int> rosterAt(long long t, long long now) const;
+
+    long long shiftsBetween(long long from, long long to) const; // boundaries in (from, to]
+    const string& unitName(int unit) const { return unitNames[unit]; }
+    long long getShiftSeconds() const { return shiftSeconds; }
+    size_t eventCount() const { return events.size(); }
+    size_t checkpointCount() const { return checkpoints.size(); }
 };
 
 // Circular Queue class
+//
+// Records live in a deque, which never moves an element once it is placed,
+// so an Ambulance* handed out stays valid for the unit's whole life. The
+// rotation order is a separate circular buffer of handles (power-of-two
+// capacity, head index): rotating only advances the head, and a scan reads
+// the handles in one contiguous sweep.
+//
+// Removing a unit leaves a tombstone (null handle) in its slot, O(1) via the
+// slot stored in the record. Tombstones at the front or rear are trimmed at
+// once, so both ends always hold a live unit; interior ones are skipped by
+// scans and squeezed out when they outnumber the live units.
+//
+// Every public member takes fleetLock, so the auto-dispatcher thread can
+// reserve units while the menu runs. Private helpers expect the lock held.
 class AmbulanceQueue
 {
 private:
-    Ambulance* front;
-    Ambulance* rear;
+    deque<Ambulance> records;                // stable storage for every unit
+    vector<Ambulance*> freeRecords;          // released records, reused first
+    vector<Ambulance*> ring;                 // rotation order, circular
+    size_t ringHead;                         // physical index of the front unit
+    size_t ringSize;                         // slots in use, tombstones included
+    size_t tombstones;
+    unordered_map<string, Ambulance*> byID; // ID -> node, keeps IDs unique
+
+    // One list per status. Units join the back when they enter a status, and
+    // rotateShift moves the front unit to the back of its list as well, so the
+    // head of the Available list is the next unit to dispatch.
+    Ambulance* statusHead[STATUS_COUNT];
+    Ambulance* statusTail[STATUS_COUNT];
+    int statusCount[STATUS_COUNT];
+
+    AmbulanceGrid availableGrid; // Available units with a position
+    ShiftRoster roster;          // history of the rotation
+    mutable mutex fleetLock;
+
+    Ambulance* findAmbulance(const string& id); // O(1) lookup, nullptr if absent
+    void linkStatus(Ambulance* unit);           // append to its status list
+    void unlinkStatus(Ambulance* unit);
+    void setStatus(Ambulance* unit, AmbulanceStatus status);
+    OpStatus applyPosition(const string& id, double x, double y); // setPosition, lock held
+    OpStatus applyStatus(const string& id, AmbulanceStatus status); // setStatus, lock held
+    void pushRotation(Ambulance* unit);         // append at the rear, grows the ring when full
+    void placeInRing(Ambulance* unit, size_t slot);
+    void trimRing();                            // drop tombstones at the front and rear
+    void rebuildRing(size_t capacity);          // live units only, front at slot 0
+    Ambulance* slotAt(size_t i) const { return ring[(ringHead + i) & (ring.size() - 1)]; }
+    void checkpointRoster();                    // after each roster event, if due
+    void rotateRing(long long k);               // k >= 0, at least one live unit
+    void eraseUnit(Ambulance* unit);            // removeAmbulance without the lookup
+
+    template <typename Visit>
+    void visitRotation(Visit visit) const
+    {
+        for (size_t i = 0; i < ringSize; i++)
+        {
+            Ambulance* unit = slotAt(i);
+            if (unit != nullptr)
+                visit(*unit);
+        }
+    }
 
 public:
     AmbulanceQueue(); // constructor
     ~AmbulanceQueue(); // destructor
 
     bool isEmpty();
+    int size() const;
     void registerAmbulance(); // add ambulance
+    OpStatus addAmbulance(const string& id, const string& driverName); // OP_DUPLICATE on a taken ID
+    OpStatus removeAmbulance(const string& id);  // O(1), OP_NOT_FOUND if the ID is unknown
+    void decommissionAmbulance();
     void rotateShift();       // rotate shift
+    OpStatus rotateOnce(string& newFrontID); // same, without console I/O
+    OpStatus rotateBy(long long k);          // k shifts at once, O(min(k, n)); OP_INVALID_ARGUMENT if k < 0
     void displaySchedule();   // display current schedule
     void updateStatus();    // update ambulance status
     void searchAmbulance();
+    void dispatchNextAvailable(); // send the next Available unit, O(1)
+    OpStatus reserveNextAvailable(string& id, string& driverName); // same, without console I/O
+    int countByStatus(AmbulanceStatus status) const;
+    OpStatus getUnit(const string& id, Ambulance& copy) const;
     void menu();              // menudriven
+
+    // Positions and nearest-unit dispatch
+    OpStatus setPosition(const string& id, double x, double y); // OP_INVALID_ARGUMENT off the grid
+    OpStatus setStatus(const string& id, AmbulanceStatus status);
+    // A batch of telemetry under one lock; results[i] is what setPosition or
+    // setStatus would have returned for updates[i]
+    void applyTelemetry(const TelemetryUpdate* updates, size_t count, OpStatus* results);
+    vector<NearbyUnit> nearestAvailable(double x, double y, int k) const; // closest first
+    int loadPositions(const string& fileName, int& skipped); // -1 if the file cannot be read
+    void loadPositionsFromFile();
+    void dispatchNearest();
+    void replayTelemetry();   // stream a telemetry replay file into the fleet
+    void viewRosterAt();      // who was / will be on shift at a given time
+
+    // Visit every unit from front to rear (holds the fleet lock throughout)
+    template <typename Visit>
+    void forEachInRotation(Visit visit) const
+    {
+        lock_guard<mutex> guard(fleetLock);
+        visitRotation(visit);
+    }
+
+    static string statusName(AmbulanceStatus status);
+    static bool parseStatus(string text, AmbulanceStatus& status);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,275 @@
+#ifndef AMBULANCE_TELEMETRY_HPP
+#define AMBULANCE_TELEMETRY_HPP
+
+#include "Ambulance.hpp"
+#include "SpscRing.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+using namespace std;
+
+enum TelemetryKind
+{
+    TELEMETRY_POSITION = 0,
+    TELEMETRY_STATUS
+};
+
+// One update from a vehicle unit. Fixed size, no heap memory, so it can be
+// copied through the ring without allocating.
+struct TelemetryUpdate
+{
+    char id[16]; // NUL-terminated ambulance ID
+    TelemetryKind kind;
+    AmbulanceStatus status;
+    double x, y;
+};
+
+struct TelemetryStats
+{
+    long long received;    // well-formed updates read by the reader thread
+    long long dropped;     // ring was full, update discarded
+    long long malformed;   // lines that could not be parsed, or positions off the grid
+    long long applied;     // changed fleet state
+    long long unknownUnit; // ID not registered in the fleet
+    long long batches;
+    size_t depth;          // updates waiting right now
+    size_t maxDepth;       // highest depth seen by the consumer
+    size_t capacity;
+};
+
+// Streams ambulance telemetry into an AmbulanceQueue.
+//
+// A reader thread (the producer) parses a replay file, the stand-in for the
+// vehicle feed, and pushes fixed-size updates into an SpscRing. The thread
+// that owns the fleet (the consumer) calls applyPending, which drains up to
+// one batch at a time and applies it under a single fleet lock; other
+// threads (the auto-dispatcher) may still use the fleet between batches.
+// Memory is bounded by the ring capacity. When the ring is full, updates
+// are dropped and counted (or the reader waits, if dropWhenFull is false).
+//
+// Replay file, one update per line (blank lines and '#' comments skipped):
+//   POS <id> <x> <y>
+//   STATUS <id> <Available|OnDuty|Maintenance>
+class AmbulanceTelemetry
+{
+private:
+    SpscRing<TelemetryUpdate> ring;
+    vector<TelemetryUpdate> batch;
+    vector<OpStatus> results; // per update of the current batch
+    bool dropWhenFull;
+
+    thread reader;
+    atomic<bool> readerDone;
+    atomic<bool> stopRequested;
+
+    // written by the reader thread
+    atomic<long long> received;
+    atomic<long long> dropped;
+    atomic<long long> malformed;
+
+    // written by the consumer thread
+    long long applied;
+    long long unknownUnit;
+    long long batches;
+    size_t maxDepth;
+
+    static const char *skipSpaces(const char *p)
+    {
+        while (*p == ' ' || *p == '\t')
+            p++;
+        return p;
+    }
+
+    // Copy the next whitespace-delimited word into out; false if empty or too long
+    static bool readWord(const char *&p, char *out, size_t outSize)
+    {
+        p = skipSpaces(p);
+        size_t n = 0;
+        while (p[n] != '\0' && p[n] != ' ' && p[n] != '\t' && p[n] != '\r' && p[n] != '\n')
+            n++;
+        if (n == 0 || n >= outSize)
+            return false;
+        memcpy(out, p, n);
+        out[n] = '\0';
+        p += n;
+        return true;
+    }
+
+    static bool readNumber(const char *&p, double &value)
+    {
+        char *end;
+        value = strtod(p, &end);
+        if (end == p)
+            return false;
+        p = end;
+        return true;
+    }
+
+    void replay(string fileName, int loops, double ratePerSecond)
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        long long sent = 0;
+        string line;
+        TelemetryUpdate update;
+
+        for (int loop = 0; loop < loops && !stopRequested.load(memory_order_relaxed); loop++)
+        {
+            ifstream file(fileName.c_str());
+            while (getline(file, line) && !stopRequested.load(memory_order_relaxed))
+            {
+                if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == string::npos)
+                    continue;
+                if (!parseLine(line.c_str(), update))
+                {
+                    malformed.fetch_add(1, memory_order_relaxed);
+                    continue;
+                }
+                offer(update);
+                sent++;
+
+                // Pace the feed when a rate is given (checked every 256 updates)
+                if (ratePerSecond > 0 && (sent & 255) == 0)
+                {
+                    chrono::duration<double> due(sent / ratePerSecond);
+                    this_thread::sleep_until(start + chrono::duration_cast<chrono::steady_clock::duration>(due));
+                }
+            }
+        }
+        readerDone.store(true, memory_order_release);
+    }
+
+public:
+    explicit AmbulanceTelemetry(size_t capacity = 8192, size_t batchSize = 256, bool dropFull = true)
+        : ring(capacity), batch(batchSize > 0 ? batchSize : 1),
+          results(batch.size()), dropWhenFull(dropFull),
+          readerDone(true), stopRequested(false), received(0), dropped(0), malformed(0),
+          applied(0), unknownUnit(0), batches(0), maxDepth(0) {}
+
+    ~AmbulanceTelemetry()
+    {
+        stop();
+    }
+
+    AmbulanceTelemetry(const AmbulanceTelemetry &) = delete;
+    AmbulanceTelemetry &operator=(const AmbulanceTelemetry &) = delete;
+
+    static bool parseLine(const char *line, TelemetryUpdate &out)
+    {
+        const char *p = line;
+        char word[16];
+        if (!readWord(p, word, sizeof(word)) || !readWord(p, out.id, sizeof(out.id)))
+            return false;
+
+        if (strcmp(word, "POS") == 0)
+        {
+            out.kind = TELEMETRY_POSITION;
+            out.status = STATUS_AVAILABLE;
+            if (!readNumber(p, out.x) || !readNumber(p, out.y))
+                return false;
+        }
+        else if (strcmp(word, "STATUS") == 0)
+        {
+            out.kind = TELEMETRY_STATUS;
+            out.x = out.y = 0;
+            if (!AmbulanceQueue::parseStatus(p, out.status))
+                return false;
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+        p = skipSpaces(p);
+        return *p == '\0' || *p == '\r' || *p == '\n';
+    }
+
+    // Producer side: queue one update, false if it was dropped
+    bool offer(const TelemetryUpdate &update)
+    {
+        received.fetch_add(1, memory_order_relaxed);
+        while (!ring.tryPush(update))
+        {
+            if (dropWhenFull || stopRequested.load(memory_order_relaxed))
+            {
+                dropped.fetch_add(1, memory_order_relaxed);
+                return false;
+            }
+            this_thread::yield();
+        }
+        return true;
+    }
+
+    // Start a reader thread replaying the file `loops` times, at most
+    // ratePerSecond updates per second (0 = as fast as possible).
+    // False if the file cannot be opened or a replay is still running.
+    bool startReplay(const string &fileName, int loops = 1, double ratePerSecond = 0)
+    {
+        if (!readerDone.load(memory_order_acquire) || !ifstream(fileName.c_str()))
+            return false;
+        if (reader.joinable())
+            reader.join();
+        stopRequested.store(false);
+        readerDone.store(false);
+        reader = thread(&AmbulanceTelemetry::replay, this, fileName, loops, ratePerSecond);
+        return true;
+    }
+
+    void stop()
+    {
+        stopRequested.store(true);
+        if (reader.joinable())
+            reader.join();
+    }
+
+    // Reader has finished and every queued update has been applied
+    bool finished() const
+    {
+        return readerDone.load(memory_order_acquire) && ring.approximateDepth() == 0;
+    }
+
+    // Consumer side: apply at most one batch to the fleet, returns the count taken
+    int applyPending(AmbulanceQueue &fleet)
+    {
+        size_t depth = ring.approximateDepth();
+        if (depth > maxDepth)
+            maxDepth = depth;
+
+        size_t n = ring.popBatch(batch.data(), batch.size());
+        if (n == 0)
+            return 0;
+        batches++;
+
+        fleet.applyTelemetry(batch.data(), n, results.data());
+        for (size_t i = 0; i < n; i++)
+        {
+            if (results[i] == OP_OK)
+                applied++;
+            else if (results[i] == OP_INVALID_ARGUMENT)
+                malformed.fetch_add(1, memory_order_relaxed);
+            else
+                unknownUnit++;
+        }
+        return (int)n;
+    }
+
+    TelemetryStats getStats() const
+    {
+        TelemetryStats s;
+        s.received = received.load(memory_order_relaxed);
+        s.dropped = dropped.load(memory_order_relaxed);
+        s.malformed = malformed.load(memory_order_relaxed);
+        s.applied = applied;
+        s.unknownUnit = unknownUnit;
+        s.batches = batches;
+        s.depth = ring.approximateDepth();
+        s.maxDepth = maxDepth;
+        s.capacity = ring.capacity();
+        return s;
+    }
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef AUTO_DISPATCH_HPP
+#define AUTO_DISPATCH_HPP
+
+#include "Ambulance.hpp"
+#include "EventBus.hpp"
+#include <atomic>
+#include <thread>
+
+using namespace std;
+
+// Consumes EVENT_CRITICAL_CASE_LOGGED on its own thread and reserves the
+// next Available ambulance for each case. The reservation (find + flip to
+// OnDuty) is one locked step in AmbulanceQueue, so the operator menu, the
+// telemetry consumer and this thread never hand out the same unit twice.
+// The outcome is published back as EVENT_AMBULANCE_ASSIGNED or
+// EVENT_DISPATCH_FAILED.
+//
+// Latency is measured from the moment the ED logged the case to the moment
+// the unit was reserved. The most recent samples are kept for reporting.
+class AutoDispatcher
+{
+private:
+    static const size_t MAX_SAMPLES = 1 << 20;
+
+    EventBus& bus;
+    AmbulanceQueue& fleet;
+    int mailbox;
+    thread worker;
+    bool stopped;
+
+    atomic<long long> assigned;
+    atomic<long long> failed;
+
+    mutable mutex samplesLock;
+    vector<long long> latencyNs; // case logged → unit reserved
+    size_t nextSample;
+
+    void record(long long ns)
+    {
+        lock_guard<mutex> guard(samplesLock);
+        if (latencyNs.size() < MAX_SAMPLES)
+            latencyNs.push_back(ns);
+        else
+            latencyNs[nextSample] = ns;
+        nextSample = (nextSample + 1) % MAX_SAMPLES;
+    }
+
+    void run()
+    {
+        HospitalEvent event;
+        string driverName;
+        while (bus.waitNext(mailbox, event))
+        {
+            if (fleet.reserveNextAvailable(event.ambulanceID, driverName) == OP_OK)
+            {
+                record(EventBus::nowNs() - event.loggedNs);
+                assigned++;
+                event.type = EVENT_AMBULANCE_ASSIGNED;
+            }
+            else
+            {
+                failed++;
+                event.type = EVENT_DISPATCH_FAILED;
+            }
+            bus.publish(event);
+        }
+    }
+
+public:
+    AutoDispatcher(EventBus& bus, AmbulanceQueue& fleet)
+        : bus(bus), fleet(fleet), stopped(false), assigned(0), failed(0), nextSample(0)
+    {
+        mailbox = bus.subscribe(EventBus::maskOf(EVENT_CRITICAL_CASE_LOGGED));
+        worker = thread(&AutoDispatcher::run, this);
+    }
+
+    ~AutoDispatcher()
+    {
+        stop();
+    }
+
+    AutoDispatcher(const AutoDispatcher&) = delete;
+    AutoDispatcher& operator=(const AutoDispatcher&) = delete;
+
+    // Finishes the cases already queued, then joins the worker
+    void stop()
+    {
+        if (stopped)
+            return;
+        stopped = true;
+        bus.close(mailbox);
+        if (worker.joinable())
+            worker.join();
+    }
+
+    long long getAssignedCount() const
+    {
+        return assigned.load();
+    }
+
+    long long getFailedCount() const
+    {
+        return failed.load();
+    }
+
+    // Copy of the retained latency samples (ns), in no particular order
+    vector<long long> latencySamples() const
+    {
+        lock_guard<mutex> guard(samplesLock);
+        return latencyNs;
+    }
+};
+
+#endif // AUTO_DISPATCH_HPP
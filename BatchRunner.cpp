@@ -0,0 +1,565 @@
+// ============================================================================
+// BatchRunner.cpp
+// Headless command mode: drives all four roles from a script, one
+// machine-readable reply line per command (see BatchRunner.hpp)
+// ============================================================================
+
+#include "BatchRunner.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <ctime>
+#include <sstream>
+
+// ==========================================================
+// Constructor
+// ==========================================================
+BatchRunner::BatchRunner(PatientQueue& patients, MedicalSupply& supplies, EmergencyDepartmentOfficer& ed,
+                         AmbulanceQueue& fleet, EventBus& bus)
+    : patients(patients), supplies(supplies), ed(ed), fleet(fleet), bus(bus),
+      dispatchRequested(0), dispatchOutcomes(0), eventOut(&cout), okCount(0), errCount(0) {
+    outcomeMailbox = bus.subscribe(EventBus::maskOf(EVENT_AMBULANCE_ASSIGNED) |
+                                   EventBus::maskOf(EVENT_DISPATCH_FAILED));
+
+    handlers["admit"] = &BatchRunner::admit;
+    handlers["discharge"] = &BatchRunner::discharge;
+    handlers["patient.find"] = &BatchRunner::patientFind;
+    handlers["patient.peek"] = &BatchRunner::patientPeek;
+    handlers["patient.count"] = &BatchRunner::patientCount;
+    handlers["supply.add"] = &BatchRunner::supplyAdd;
+    handlers["supply.use"] = &BatchRunner::supplyUse;
+    handlers["supply.dispense"] = &BatchRunner::supplyDispense;
+    handlers["supply.purge"] = &BatchRunner::supplyPurge;
+    handlers["supply.count"] = &BatchRunner::supplyCount;
+    handlers["ed.log"] = &BatchRunner::edLog;
+    handlers["ed.next"] = &BatchRunner::edNext;
+    handlers["ed.complete"] = &BatchRunner::edComplete;
+    handlers["ed.count"] = &BatchRunner::edCount;
+    handlers["amb.add"] = &BatchRunner::ambAdd;
+    handlers["amb.remove"] = &BatchRunner::ambRemove;
+    handlers["amb.status"] = &BatchRunner::ambStatus;
+    handlers["amb.pos"] = &BatchRunner::ambPosition;
+    handlers["amb.rotate"] = &BatchRunner::ambRotate;
+    handlers["amb.dispatch"] = &BatchRunner::ambDispatch;
+    handlers["amb.nearest"] = &BatchRunner::ambNearest;
+    handlers["amb.find"] = &BatchRunner::ambFind;
+    handlers["amb.count"] = &BatchRunner::ambCount;
+    handlers["sync"] = &BatchRunner::sync;
+    handlers["stats"] = &BatchRunner::stats;
+}
+
+// ==========================================================
+// Parsing and formatting
+// ==========================================================
+bool BatchRunner::tokenize(const string& line, string& command, BatchArgs& args, string& error) {
+    size_t i = 0;
+    size_t n = line.size();
+    command.clear();
+    args.clear();
+
+    while (i < n) {
+        while (i < n && (line[i] == ' ' || line[i] == '\t')) i++;
+        if (i >= n) break;
+
+        size_t start = i;
+        while (i < n && line[i] != ' ' && line[i] != '\t' && line[i] != '=') i++;
+        string key = line.substr(start, i - start);
+
+        if (command.empty()) {
+            if (i < n && line[i] == '=') {
+                error = "command name expected before '" + key + "='";
+                return false;
+            }
+            command = key;
+            continue;
+        }
+        if (i >= n || line[i] != '=') {
+            error = "expected key=value, got '" + key + "'";
+            return false;
+        }
+        i++; // '='
+
+        string value;
+        if (i < n && line[i] == '"') {
+            i++;
+            while (i < n && line[i] != '"') {
+                if (line[i] == '\\' && i + 1 < n) i++;
+                value += line[i++];
+            }
+            if (i >= n) {
+                error = "unterminated quote in " + key;
+                return false;
+            }
+            i++; // closing quote
+        } else {
+            while (i < n && line[i] != ' ' && line[i] != '\t') value += line[i++];
+        }
+        args[key] = value;
+    }
+    return true;
+}
+
+// " key=value", quoted when the value would not survive tokenize() bare
+string BatchRunner::field(const string& key, const string& value) {
+    bool quote = value.empty() || value.find_first_of(" \t\"=") != string::npos;
+    if (!quote) return " " + key + "=" + value;
+
+    string text = " " + key + "=\"";
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value[i] == '"' || value[i] == '\\') text += '\\';
+        text += value[i];
+    }
+    return text + "\"";
+}
+
+bool BatchRunner::need(const BatchArgs& args, const char* key, string& value, string& error) {
+    BatchArgs::const_iterator it = args.find(key);
+    if (it == args.end() || it->second.empty()) {
+        error = string("missing ") + key + "=";
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+bool BatchRunner::needInt(const BatchArgs& args, const char* key, long& value, string& error) {
+    string text;
+    if (!need(args, key, text, error)) return false;
+    char* end = nullptr;
+    errno = 0;
+    value = strtol(text.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0') {
+        error = string(key) + " must be an integer";
+        return false;
+    }
+    return true;
+}
+
+bool BatchRunner::needDouble(const BatchArgs& args, const char* key, double& value, string& error) {
+    string text;
+    if (!need(args, key, text, error)) return false;
+    char* end = nullptr;
+    errno = 0;
+    value = strtod(text.c_str(), &end);
+    if (errno != 0 || *end != '\0') {
+        error = string(key) + " must be a number";
+        return false;
+    }
+    return true;
+}
+
+string BatchRunner::describePatient(const PatientRecord& p) {
+    int minutesWaited = (int)difftime(time(0), p.admittedTimeRaw) / 60;
+    return field("id", p.patientID) + field("name", p.name) + field("cond", p.conditionType) +
+           field("admitted", p.admittedAt) + field("waited_min", to_string(minutesWaited));
+}
+
+// ==========================================================
+// Dispatch outcome events
+// ==========================================================
+void BatchRunner::printEvent(const HospitalEvent& event, ostream& out) {
+    if (event.type == EVENT_AMBULANCE_ASSIGNED) {
+        out << "event amb.assigned" << field("case", to_string(event.caseID))
+            << field("unit", event.ambulanceID) << '\n';
+    } else {
+        out << "event amb.unavailable" << field("case", to_string(event.caseID)) << '\n';
+    }
+    dispatchOutcomes++;
+}
+
+void BatchRunner::printEvents(ostream& out, bool waitForAll) {
+    HospitalEvent event;
+    while (bus.pollNext(outcomeMailbox, event)) {
+        printEvent(event, out);
+    }
+    while (waitForAll && dispatchOutcomes < dispatchRequested && bus.waitNext(outcomeMailbox, event)) {
+        printEvent(event, out);
+    }
+}
+
+// ==========================================================
+// Driver
+// ==========================================================
+bool BatchRunner::execute(const string& line, int lineNumber, ostream& out) {
+    size_t start = line.find_first_not_of(" \t\r");
+    if (start == string::npos || line[start] == '#') return true;
+
+    string command;
+    BatchArgs args;
+    string reply;
+    bool ok = tokenize(line.substr(0, line.find_last_not_of(" \t\r") + 1), command, args, reply);
+    if (ok) {
+        unordered_map<string, Handler>::const_iterator it = handlers.find(command);
+        if (it == handlers.end()) {
+            ok = false;
+            reply = "unknown command";
+        } else {
+            eventOut = &out;
+            ok = (this->*(it->second))(args, reply);
+        }
+    }
+
+    if (ok) {
+        out << "ok " << command << reply << '\n';
+        okCount++;
+    } else {
+        out << "err " << command << field("line", to_string(lineNumber)) << field("reason", reply) << '\n';
+        errCount++;
+    }
+    printEvents(out, false);
+    return ok;
+}
+
+void BatchRunner::run(istream& in, ostream& out) {
+    string line;
+    int lineNumber = 0;
+    while (getline(in, line)) {
+        execute(line, ++lineNumber, out);
+    }
+}
+
+void BatchRunner::finish(ostream& out) {
+    printEvents(out, true);
+    out.flush();
+}
+
+// ==========================================================
+// Patient admission (Role 1)
+// ==========================================================
+bool BatchRunner::admit(const BatchArgs& args, string& reply) {
+    string name, cond;
+    if (!need(args, "name", name, reply) || !need(args, "cond", cond, reply)) return false;
+    PatientRecord patient(name, cond);
+    if (patients.admit(patient) != OP_OK) {
+        reply = "cond must be Normal, Critical or Emergency";
+        return false;
+    }
+    reply = field("id", patient.patientID) + field("queue", to_string(patients.count()));
+    return true;
+}
+
+bool BatchRunner::discharge(const BatchArgs&, string& reply) {
+    PatientRecord p;
+    if (patients.discharge(p) != OP_OK) {
+        reply = "no patients to discharge";
+        return false;
+    }
+    reply = describePatient(p) + field("queue", to_string(patients.count()));
+    return true;
+}
+
+bool BatchRunner::patientFind(const BatchArgs& args, string& reply) {
+    string id;
+    if (!need(args, "id", id, reply)) return false;
+    PatientRecord p;
+    if (patients.find(id, p) != OP_OK) {
+        reply = "no patient with ID " + id;
+        return false;
+    }
+    reply = describePatient(p);
+    return true;
+}
+
+bool BatchRunner::patientPeek(const BatchArgs&, string& reply) {
+    PatientRecord p;
+    if (patients.peek(p) != OP_OK) {
+        reply = "no patients in queue";
+        return false;
+    }
+    reply = describePatient(p);
+    return true;
+}
+
+bool BatchRunner::patientCount(const BatchArgs&, string& reply) {
+    reply = field("count", to_string(patients.count()));
+    return true;
+}
+
+// ==========================================================
+// Medical supply (Role 2)
+// ==========================================================
+bool BatchRunner::supplyAdd(const BatchArgs& args, string& reply) {
+    string type, expiry;
+    long qty;
+    if (!need(args, "type", type, reply) || !needInt(args, "qty", qty, reply) ||
+        !need(args, "expiry", expiry, reply)) {
+        return false;
+    }
+    BatchArgs::const_iterator remark = args.find("remark");
+    string batchID;
+    if (supplies.addStock(type, (int)qty, expiry, remark == args.end() ? "" : remark->second, &batchID) != OP_OK) {
+        reply = "qty must be positive and expiry a valid future YYYY-MM-DD";
+        return false;
+    }
+    reply = field("batch", batchID) + field("items", to_string(supplies.getItemCount()));
+    return true;
+}
+
+bool BatchRunner::supplyUse(const BatchArgs& args, string& reply) {
+    long qty;
+    if (!needInt(args, "qty", qty, reply)) return false;
+    const SupplyItem* item = supplies.peekTop();
+    if (item == nullptr) {
+        reply = "no supplies available";
+        return false;
+    }
+    string type = item->type;
+    string batch = item->batch;
+    int inStock = item->quantity;
+    int left = 0;
+    if (supplies.useLast((int)qty, &left) != OP_OK) {
+        reply = qty <= 0 ? "qty must be positive" : "not enough quantity, " + to_string(inStock) + " in stock";
+        return false;
+    }
+    reply = field("type", type) + field("batch", batch) + field("left", to_string(left));
+    return true;
+}
+
+bool BatchRunner::supplyDispense(const BatchArgs& args, string& reply) {
+    string type;
+    long qty;
+    if (!need(args, "type", type, reply) || !needInt(args, "qty", qty, reply)) return false;
+    int inStock = supplies.quantityOf(type);
+    OpStatus status = supplies.dispense(type, (int)qty);
+    if (status != OP_OK) {
+        reply = status == OP_INSUFFICIENT ? "not enough quantity, " + to_string(inStock) + " in stock"
+                                          : string(opStatusText(status));
+        return false;
+    }
+    reply = field("type", type) + field("left", to_string(inStock - qty));
+    return true;
+}
+
+bool BatchRunner::supplyPurge(const BatchArgs&, string& reply) {
+    int removed = supplies.purgeExpired();
+    reply = field("removed", to_string(removed)) + field("items", to_string(supplies.getItemCount()));
+    return true;
+}
+
+bool BatchRunner::supplyCount(const BatchArgs&, string& reply) {
+    reply = field("items", to_string(supplies.getItemCount()));
+    return true;
+}
+
+// ==========================================================
+// Emergency department (Role 3)
+// ==========================================================
+bool BatchRunner::edLog(const BatchArgs& args, string& reply) {
+    string name, type;
+    long priority;
+    if (!need(args, "name", name, reply) || !need(args, "type", type, reply) ||
+        !needInt(args, "priority", priority, reply)) {
+        return false;
+    }
+    if (priority < 1 || priority > 10) {
+        reply = "priority must be 1-10";
+        return false;
+    }
+    BatchArgs::const_iterator notes = args.find("notes");
+    int caseID = 0;
+    OpStatus status = ed.logCase(EmergencyCase(0, name, type, (int)priority,
+                                               notes == args.end() ? "" : notes->second), &caseID);
+    if (status != OP_OK) {
+        reply = string("case not logged: ") + opStatusText(status);
+        return false;
+    }
+    bool dispatch = priority >= ed.getDispatchThreshold();
+    if (dispatch) dispatchRequested++;
+    reply = field("case", to_string(caseID)) + field("pending", to_string(ed.getPendingCount())) +
+            field("dispatch", dispatch ? "requested" : "none");
+    return true;
+}
+
+bool BatchRunner::edNext(const BatchArgs&, string& reply) {
+    EmergencyCase called;
+    int bayID;
+    if (ed.callNextCase(called, bayID) != OP_OK) {
+        reply = "no pending cases";
+        return false;
+    }
+    reply = field("case", to_string(called.caseID)) + field("name", called.patientName) +
+            field("priority", to_string(called.priorityLevel)) +
+            field("bay", bayID != -1 ? ed.bayLabel(bayID) : "waiting") +
+            field("pending", to_string(ed.getPendingCount()));
+    return true;
+}
+
+bool BatchRunner::edComplete(const BatchArgs& args, string& reply) {
+    long caseID;
+    if (!needInt(args, "case", caseID, reply)) return false;
+    EmergencyCase discharged;
+    int reassignedCaseID;
+    if (ed.finishCase((int)caseID, discharged, reassignedCaseID) != OP_OK) {
+        reply = "case " + to_string(caseID) + " is not in treatment";
+        return false;
+    }
+    reply = field("case", to_string(discharged.caseID)) +
+            field("next", reassignedCaseID != -1 ? to_string(reassignedCaseID) : "none") +
+            field("treating", to_string(ed.getInTreatmentCount()));
+    return true;
+}
+
+bool BatchRunner::edCount(const BatchArgs&, string& reply) {
+    reply = field("pending", to_string(ed.getPendingCount())) +
+            field("treating", to_string(ed.getInTreatmentCount()));
+    return true;
+}
+
+// ==========================================================
+// Ambulance dispatch (Role 4)
+// ==========================================================
+bool BatchRunner::ambAdd(const BatchArgs& args, string& reply) {
+    string id, driver;
+    if (!need(args, "id", id, reply) || !need(args, "driver", driver, reply)) return false;
+    OpStatus status = fleet.addAmbulance(id, driver);
+    if (status != OP_OK) {
+        reply = status == OP_DUPLICATE ? "ambulance " + id + " already exists" : string(opStatusText(status));
+        return false;
+    }
+    reply = field("id", id) + field("units", to_string(fleet.size()));
+    return true;
+}
+
+bool BatchRunner::ambRemove(const BatchArgs& args, string& reply) {
+    string id;
+    if (!need(args, "id", id, reply)) return false;
+    if (fleet.removeAmbulance(id) != OP_OK) {
+        reply = "no ambulance " + id;
+        return false;
+    }
+    reply = field("id", id) + field("units", to_string(fleet.size()));
+    return true;
+}
+
+bool BatchRunner::ambStatus(const BatchArgs& args, string& reply) {
+    string id, text;
+    AmbulanceStatus status;
+    if (!need(args, "id", id, reply) || !need(args, "status", text, reply)) return false;
+    if (!AmbulanceQueue::parseStatus(text, status)) {
+        reply = "status must be Available, OnDuty or Maintenance";
+        return false;
+    }
+    if (fleet.setStatus(id, status) != OP_OK) {
+        reply = "no ambulance " + id;
+        return false;
+    }
+    reply = field("id", id) + field("status", AmbulanceQueue::statusName(status));
+    return true;
+}
+
+bool BatchRunner::ambPosition(const BatchArgs& args, string& reply) {
+    string id;
+    double x, y;
+    if (!need(args, "id", id, reply) || !needDouble(args, "x", x, reply) || !needDouble(args, "y", y, reply)) {
+        return false;
+    }
+    OpStatus status = fleet.setPosition(id, x, y);
+    if (status != OP_OK) {
+        reply = status == OP_INVALID_ARGUMENT ? "position out of range" : "no ambulance " + id;
+        return false;
+    }
+    reply = field("id", id);
+    return true;
+}
+
+bool BatchRunner::ambRotate(const BatchArgs& args, string& reply) {
+    if (args.count("k") != 0) {
+        long k;
+        if (!needInt(args, "k", k, reply)) return false;
+        OpStatus status = fleet.rotateBy(k);
+        if (status != OP_OK) {
+            reply = status == OP_INVALID_ARGUMENT ? "k must not be negative" : "no ambulances to rotate";
+            return false;
+        }
+        reply = field("k", to_string(k));
+        return true;
+    }
+    string front;
+    if (fleet.rotateOnce(front) != OP_OK) {
+        reply = "no ambulances to rotate";
+        return false;
+    }
+    reply = field("front", front);
+    return true;
+}
+
+bool BatchRunner::ambDispatch(const BatchArgs&, string& reply) {
+    string id, driver;
+    if (fleet.reserveNextAvailable(id, driver) != OP_OK) {
+        reply = "no ambulance available";
+        return false;
+    }
+    reply = field("id", id) + field("driver", driver);
+    return true;
+}
+
+bool BatchRunner::ambNearest(const BatchArgs& args, string& reply) {
+    double x, y;
+    if (!needDouble(args, "x", x, reply) || !needDouble(args, "y", y, reply)) return false;
+    vector<NearbyUnit> found = fleet.nearestAvailable(x, y, 1);
+    if (found.empty()) {
+        reply = "no available ambulance with a position";
+        return false;
+    }
+    ostringstream distance;
+    distance << found[0].distance;
+    reply = field("id", found[0].id) + field("distance", distance.str());
+    return true;
+}
+
+bool BatchRunner::ambFind(const BatchArgs& args, string& reply) {
+    string id;
+    Ambulance unit;
+    if (!need(args, "id", id, reply)) return false;
+    if (fleet.getUnit(id, unit) != OP_OK) {
+        reply = "no ambulance " + id;
+        return false;
+    }
+    reply = field("id", unit.id) + field("driver", unit.driverName) +
+            field("status", AmbulanceQueue::statusName(unit.status));
+    if (unit.hasPosition) {
+        ostringstream position;
+        position << unit.x << "," << unit.y;
+        reply += field("pos", position.str());
+    }
+    return true;
+}
+
+bool BatchRunner::ambCount(const BatchArgs&, string& reply) {
+    reply = field("units", to_string(fleet.size()));
+    for (int s = 0; s < STATUS_COUNT; s++) {
+        string name = AmbulanceQueue::statusName((AmbulanceStatus)s);
+        for (size_t i = 0; i < name.size(); i++) name[i] = (char)tolower((unsigned char)name[i]);
+        reply += field(name, to_string(fleet.countByStatus((AmbulanceStatus)s)));
+    }
+    return true;
+}
+
+// ==========================================================
+// Wait until every requested auto-dispatch has an outcome
+// ==========================================================
+bool BatchRunner::sync(const BatchArgs&, string& reply) {
+    printEvents(*eventOut, true);
+    reply = field("dispatched", to_string(dispatchOutcomes));
+    return true;
+}
+
+// ==========================================================
+// Calls and sampled latency of the instrumented operations
+// ==========================================================
+bool BatchRunner::stats(const BatchArgs&, string& reply) {
+    reply = field("enabled", instrumentationEnabled() ? "1" : "0");
+    if (!instrumentationEnabled()) return true;
+
+    reply += field("sample_every", to_string(HOSPITAL_INSTRUMENTATION_SAMPLE_EVERY));
+    for (int op = 0; op < METRIC_OPERATION_COUNT; op++) {
+        OperationSnapshot s = InstrumentationRegistry::instance().snapshot(op);
+        ostringstream p50, p99, maxUs;
+        p50 << fixed << setprecision(2) << s.quantileNs(0.5) / 1000;
+        p99 << fixed << setprecision(2) << s.quantileNs(0.99) / 1000;
+        maxUs << fixed << setprecision(2) << s.maxNs / 1000.0;
+        string name = metricName(op);
+        reply += field(name + ".calls", to_string(s.calls)) + field(name + ".p50_us", p50.str()) +
+                 field(name + ".p99_us", p99.str()) + field(name + ".max_us", maxUs.str());
+    }
+    return true;
+}
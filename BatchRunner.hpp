@@ -0,0 +1,110 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include "PatientAdmission.hpp"
+#include "MedicalSupply.hpp"
+#include "EmergencyDepartment.hpp"
+#include "Ambulance.hpp"
+#include "EventBus.hpp"
+#include "Instrumentation.hpp"
+
+using namespace std;
+
+typedef map<string, string> BatchArgs;
+
+// Headless driver for all four roles (`hospital --batch <file|->`).
+//
+// Reads one command per line, `name key=value ...` (values with spaces in
+// double quotes; blank lines and '#' comments skipped), and answers each
+// with exactly one line:
+//   ok <command> key=value ...
+//   err <command> line=<n> reason="..."
+// Auto-dispatch outcomes arrive asynchronously as
+//   event amb.assigned case=<id> unit=<id>   /   event amb.unavailable case=<id>
+// printed between commands as they come in; `sync` waits for all of them.
+// No prompts, no screen clearing, no pauses.
+//
+// Commands:
+//   admit name= cond=Normal|Critical|Emergency   discharge
+//   patient.find id=   patient.peek   patient.count
+//   supply.add type= qty= expiry=YYYY-MM-DD [remark=]   supply.use qty=
+//   supply.dispense type= qty=   supply.purge   supply.count
+//   ed.log name= type= priority=1-10 [notes=]   ed.next   ed.complete case=
+//   ed.count
+//   amb.add id= driver=   amb.remove id=   amb.status id= status=
+//   amb.pos id= x= y=   amb.rotate [k=]   amb.dispatch   amb.nearest x= y=
+//   amb.find id=   amb.count
+//   sync   stats (per-operation calls and latency, see Instrumentation.hpp)
+class BatchRunner {
+private:
+    typedef bool (BatchRunner::*Handler)(const BatchArgs& args, string& reply);
+
+    PatientQueue& patients;
+    MedicalSupply& supplies;
+    EmergencyDepartmentOfficer& ed;
+    AmbulanceQueue& fleet;
+    EventBus& bus;
+    unordered_map<string, Handler> handlers;
+
+    int outcomeMailbox;          // EVENT_AMBULANCE_ASSIGNED / EVENT_DISPATCH_FAILED
+    long long dispatchRequested; // critical cases logged
+    long long dispatchOutcomes;  // outcome events printed
+    ostream* eventOut;           // where sync prints the events it waits for
+
+    long long okCount;
+    long long errCount;
+
+    static bool tokenize(const string& line, string& command, BatchArgs& args, string& error);
+    static string field(const string& key, const string& value);
+    static bool need(const BatchArgs& args, const char* key, string& value, string& error);
+    static bool needInt(const BatchArgs& args, const char* key, long& value, string& error);
+    static bool needDouble(const BatchArgs& args, const char* key, double& value, string& error);
+    static string describePatient(const PatientRecord& p);
+
+    void printEvent(const HospitalEvent& event, ostream& out);
+    void printEvents(ostream& out, bool waitForAll);
+
+    bool admit(const BatchArgs& args, string& reply);
+    bool discharge(const BatchArgs& args, string& reply);
+    bool patientFind(const BatchArgs& args, string& reply);
+    bool patientPeek(const BatchArgs& args, string& reply);
+    bool patientCount(const BatchArgs& args, string& reply);
+    bool supplyAdd(const BatchArgs& args, string& reply);
+    bool supplyUse(const BatchArgs& args, string& reply);
+    bool supplyDispense(const BatchArgs& args, string& reply);
+    bool supplyPurge(const BatchArgs& args, string& reply);
+    bool supplyCount(const BatchArgs& args, string& reply);
+    bool edLog(const BatchArgs& args, string& reply);
+    bool edNext(const BatchArgs& args, string& reply);
+    bool edComplete(const BatchArgs& args, string& reply);
+    bool edCount(const BatchArgs& args, string& reply);
+    bool ambAdd(const BatchArgs& args, string& reply);
+    bool ambRemove(const BatchArgs& args, string& reply);
+    bool ambStatus(const BatchArgs& args, string& reply);
+    bool ambPosition(const BatchArgs& args, string& reply);
+    bool ambRotate(const BatchArgs& args, string& reply);
+    bool ambDispatch(const BatchArgs& args, string& reply);
+    bool ambNearest(const BatchArgs& args, string& reply);
+    bool ambFind(const BatchArgs& args, string& reply);
+    bool ambCount(const BatchArgs& args, string& reply);
+    bool sync(const BatchArgs& args, string& reply);
+    bool stats(const BatchArgs& args, string& reply);
+
+public:
+    // `ed` must already be attached to `bus` for ed.log to request dispatch
+    BatchRunner(PatientQueue& patients, MedicalSupply& supplies, EmergencyDepartmentOfficer& ed,
+                AmbulanceQueue& fleet, EventBus& bus);
+
+    bool execute(const string& line, int lineNumber, ostream& out); // false on err
+    void run(istream& in, ostream& out);
+    void finish(ostream& out); // wait for outstanding dispatch outcomes
+
+    long long getOkCount() const { return okCount; }
+    long long getErrCount() const { return errCount; }
+};
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef CONCURRENT_TRIAGE_QUEUE_HPP
+#define CONCURRENT_TRIAGE_QUEUE_HPP
+
+#include "EmergencyDepartment.hpp"
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Shared pending-case pool for several EmergencyDepartmentOfficer stations.
+//
+// Two lanes:
+// - Critical lane (priority >= threshold, default 8): one locked heap with
+//   strict priority order. Officers always drain it first, so a critical
+//   case that is logged before an extraction starts is never passed over
+//   for a lower-priority case.
+// - Relaxed lane (everything else): a MultiQueue of several small locked
+//   heaps. Inserts go to a random heap, extracts compare the tops of two
+//   random heaps and take the better one. No global lock is shared, and the
+//   expected rank error is bounded by the number of heaps (O(heapCount)).
+//
+// Building block only: the interactive ED runs a single officer on one
+// EmergencyPriorityQueue and does not use this class. It is exercised by
+// bench/ConcurrentTriageBench.cpp.
+class ConcurrentTriageQueue {
+private:
+    struct SubQueue {
+        mutex lock;
+        EmergencyPriorityQueue heap;
+        atomic<int> topPriority;   // 0 when empty, read without the lock
+        char padding[64];          // keep neighbouring locks off one cache line
+
+        SubQueue() : heap(64), topPriority(0) {}
+    };
+
+    int criticalThreshold;
+    mutex criticalLock;
+    EmergencyPriorityQueue criticalHeap;
+    atomic<int> criticalPending;
+
+    vector<SubQueue*> subQueues;
+    atomic<int> relaxedPending;
+
+    static unsigned nextRandom() {
+        static thread_local unsigned state =
+            (unsigned)hash<thread::id>()(this_thread::get_id()) | 1u;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    static void refreshTop(SubQueue& q) {
+        q.topPriority.store(q.heap.isEmpty() ? 0 : q.heap.peekMostCritical().priorityLevel,
+                            memory_order_release);
+    }
+
+    bool tryExtractCritical(EmergencyCase& out) {
+        lock_guard<mutex> guard(criticalLock);
+        if (criticalHeap.isEmpty()) {
+            return false;
+        }
+        out = criticalHeap.extractMostCritical();
+        criticalPending.fetch_sub(1);
+        return true;
+    }
+
+public:
+    // heapCount defaults to two relaxed heaps per expected officer thread
+    ConcurrentTriageQueue(int officerThreads = 4, int heapsPerThread = 2, int threshold = 8)
+        : criticalThreshold(threshold), criticalHeap(64), criticalPending(0), relaxedPending(0) {
+        int heapCount = officerThreads * heapsPerThread;
+        if (heapCount < 2) heapCount = 2;
+        for (int i = 0; i < heapCount; i++) {
+            subQueues.push_back(new SubQueue());
+        }
+    }
+
+    ~ConcurrentTriageQueue() {
+        for (size_t i = 0; i < subQueues.size(); i++) {
+            delete subQueues[i];
+        }
+    }
+
+    void insert(EmergencyCase newCase) {
+        if (newCase.priorityLevel >= criticalThreshold) {
+            lock_guard<mutex> guard(criticalLock);
+            criticalHeap.insertEmergencyCase(std::move(newCase));
+            criticalPending.fetch_add(1);
+            return;
+        }
+
+        for (;;) {
+            SubQueue& q = *subQueues[nextRandom() % subQueues.size()];
+            unique_lock<mutex> guard(q.lock, try_to_lock);
+            if (!guard.owns_lock()) {
+                continue;
+            }
+            q.heap.insertEmergencyCase(std::move(newCase));
+            refreshTop(q);
+            relaxedPending.fetch_add(1);
+            return;
+        }
+    }
+
+    // Take the next case; false only when the pool is empty
+    bool tryExtract(EmergencyCase& out) {
+        for (;;) {
+            if (criticalPending.load() > 0 && tryExtractCritical(out)) {
+                return true;
+            }
+            if (relaxedPending.load() == 0) {
+                if (criticalPending.load() == 0) {
+                    return false;
+                }
+                continue;
+            }
+
+            // Two-choice pick between random heaps
+            size_t count = subQueues.size();
+            SubQueue* a = subQueues[nextRandom() % count];
+            SubQueue* b = subQueues[nextRandom() % count];
+            if (b->topPriority.load(memory_order_acquire) > a->topPriority.load(memory_order_acquire)) {
+                a = b;
+            }
+            if (a->topPriority.load(memory_order_acquire) == 0) {
+                // Both looked empty; sweep once so a sparse pool still drains
+                for (size_t i = 0; i < count; i++) {
+                    if (subQueues[i]->topPriority.load(memory_order_acquire) > 0) {
+                        a = subQueues[i];
+                        break;
+                    }
+                }
+            }
+
+            unique_lock<mutex> guard(a->lock, try_to_lock);
+            if (!guard.owns_lock()) {
+                continue;
+            }
+
+            // A critical case may have arrived while we were choosing
+            if (criticalPending.load() > 0 || a->heap.isEmpty()) {
+                continue;
+            }
+            out = a->heap.extractMostCritical();
+            refreshTop(*a);
+            relaxedPending.fetch_sub(1);
+            return true;
+        }
+    }
+
+    int approximateSize() const {
+        return criticalPending.load() + relaxedPending.load();
+    }
+
+    int getHeapCount() const {
+        return (int)subQueues.size();
+    }
+
+    int getCriticalThreshold() const {
+        return criticalThreshold;
+    }
+};
+
+#endif // CONCURRENT_TRIAGE_QUEUE_HPP
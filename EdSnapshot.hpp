@@ -0,0 +1,444 @@
+#ifndef ED_SNAPSHOT_HPP
+#define ED_SNAPSHOT_HPP
+
+#include "EmergencyDepartment.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// ED binary snapshot (version 2)
+// ----------------------------------------------------------------------------
+// Layout (host byte order, little-endian on every target we build for):
+//   header   : magic "EDSNAP01", u32 version, u32 heapArity,
+//              i32 nextCaseID, i32 slaBreachCount,
+//              u64 pendingCount, u64 waitingCount, u64 treatmentCount
+//   pending  : pendingCount case records in raw heap order
+//   waiting  : waitingCount called cases still queued for a bay
+//   treatment: treatmentCount case records + startedAt + i32 bayID,
+//              in start order
+//   trailer  : u64 FNV-1a hash (64-bit words) of everything before it
+// case record: i32 caseID, i32 priorityLevel, i64 arrivalTimeRaw,
+//              str patientName, str emergencyType, str arrivalTime,
+//              str additionalNotes         (str = u32 length + bytes)
+//
+// Writes go to "<path>.tmp" and are renamed over the target once flushed,
+// so a crash never leaves a half-written snapshot behind. Loading maps the
+// file into memory, checks it end to end, then decodes the cases straight
+// into the heap's pool in their saved order (no re-heapify). A snapshot
+// saved with another heap arity, with pending cases out of heap order, or
+// with bays the current allocator cannot hand out is rejected, and so is one
+// that repeats a case ID or holds an ID at or past its nextCaseID.
+// ============================================================================
+
+struct EdSnapshotState {
+    int nextCaseID;
+    int slaBreachCount;
+    vector<int> treatmentBayIDs;        // bay of each treated case, start order
+    vector<EmergencyCase> awaitingBay;  // called cases queued for a bay
+
+    EdSnapshotState() : nextCaseID(1001), slaBreachCount(0) {}
+};
+
+class EdSnapshot {
+public:
+    static const uint32_t VERSION = 2;
+
+    static bool write(const string& path, EmergencyPriorityQueue& pending,
+                      const TreatmentBoard& board, const EdSnapshotState& state, string& error) {
+        if (state.treatmentBayIDs.size() != (size_t)board.size()) {
+            error = "treatment bays do not match the treatment board";
+            return false;
+        }
+        string body;
+        body.reserve(64 + (size_t)pending.getSize() * 96);
+
+        body.append(magic(), 8);
+        putU32(body, VERSION);
+        putU32(body, EmergencyPriorityQueue::getHeapArity());
+        putU32(body, (uint32_t)state.nextCaseID);
+        putU32(body, (uint32_t)state.slaBreachCount);
+        putU64(body, (uint64_t)pending.getSize());
+        putU64(body, (uint64_t)state.awaitingBay.size());
+        putU64(body, (uint64_t)board.size());
+
+        for (int i = 0; i < pending.getSize(); i++) {
+            putCase(body, pending.caseAt(i));
+        }
+        for (size_t i = 0; i < state.awaitingBay.size(); i++) {
+            putCase(body, state.awaitingBay[i]);
+        }
+        size_t treated = 0;
+        board.forEachInStartOrder([&](const EmergencyCase& c, const string& startedAt) {
+            putCase(body, c);
+            putString(body, startedAt);
+            putU32(body, (uint32_t)state.treatmentBayIDs[treated++]);
+        });
+        putU64(body, fnv1a(body.data(), body.size()));
+
+        string tempPath = path + ".tmp";
+        FILE* file = fopen(tempPath.c_str(), "wb");
+        if (file == nullptr) {
+            error = "cannot create " + tempPath;
+            return false;
+        }
+        bool written = fwrite(body.data(), 1, body.size(), file) == body.size();
+        written = (fflush(file) == 0) && written;
+#ifndef _WIN32
+        written = (fsync(fileno(file)) == 0) && written;
+#endif
+        written = (fclose(file) == 0) && written;
+        if (!written) {
+            remove(tempPath.c_str());
+            error = "write to " + tempPath + " failed";
+            return false;
+        }
+#ifdef _WIN32
+        remove(path.c_str());   // rename does not replace on Windows
+#endif
+        if (rename(tempPath.c_str(), path.c_str()) != 0) {
+            remove(tempPath.c_str());
+            error = "cannot replace " + path;
+            return false;
+        }
+        return true;
+    }
+
+    // Replaces pending/board/state only when the whole file checks out.
+    // Saved bays are checked against bays (every one must exist, fit its
+    // case and be used once); the caller re-occupies them from state.
+    static bool read(const string& path, EmergencyPriorityQueue& pending,
+                     TreatmentBoard& board, EdSnapshotState& state,
+                     const BayAllocator& bays, string& error) {
+        MappedFile mapped;
+        if (!mapped.open(path)) {
+            error = "cannot open " + path;
+            return false;
+        }
+
+        Reader in(mapped.data, mapped.size);
+        if (mapped.size < 8 + 8 || memcmp(mapped.data, magic(), 8) != 0) {
+            error = "not an ED snapshot";
+            return false;
+        }
+        uint64_t stored;
+        memcpy(&stored, mapped.data + mapped.size - 8, 8);
+        if (fnv1a(mapped.data, mapped.size - 8) != stored) {
+            error = "snapshot is corrupt (checksum mismatch)";
+            return false;
+        }
+        in.skip(8);
+
+        uint32_t version = in.u32();
+        if (version != VERSION) {
+            error = "unsupported snapshot version " + to_string(version);
+            return false;
+        }
+        uint32_t arity = in.u32();
+        if (arity != EmergencyPriorityQueue::getHeapArity()) {
+            error = "snapshot was saved with heap arity " + to_string(arity) + ", this build uses " +
+                    to_string(EmergencyPriorityQueue::getHeapArity());
+            return false;
+        }
+        EdSnapshotState loaded;
+        loaded.nextCaseID = (int)in.u32();
+        loaded.slaBreachCount = (int)in.u32();
+        uint64_t pendingCount = in.u64();
+        uint64_t waitingCount = in.u64();
+        uint64_t treatmentCount = in.u64();
+        if (pendingCount > mapped.size || waitingCount > mapped.size || treatmentCount > mapped.size) {
+            error = "snapshot is truncated";
+            return false;
+        }
+
+        // Walk the pending records once, reading only their IDs and
+        // priorities, so nothing is replaced unless the layout, the case
+        // IDs and the heap order check out
+        size_t pendingStart = in.position;
+        vector<int> priorities;
+        vector<int> caseIDs;
+        priorities.reserve((size_t)pendingCount);
+        caseIDs.reserve((size_t)(pendingCount + waitingCount + treatmentCount));
+        for (uint64_t i = 0; i < pendingCount && in.ok; i++) {
+            caseIDs.push_back(0);
+            priorities.push_back(skipCase(in, caseIDs.back()));
+        }
+
+        for (uint64_t i = 0; i < waitingCount && in.ok; i++) {
+            loaded.awaitingBay.push_back(EmergencyCase());
+            readCase(in, loaded.awaitingBay.back());
+            caseIDs.push_back(loaded.awaitingBay.back().caseID);
+        }
+
+        vector<pair<EmergencyCase, string> > treating;
+        set<int> usedBays;
+        bool baysFit = true;
+        for (uint64_t i = 0; i < treatmentCount && in.ok; i++) {
+            treating.push_back(pair<EmergencyCase, string>());
+            readCase(in, treating.back().first);
+            caseIDs.push_back(treating.back().first.caseID);
+            treating.back().second = in.str();
+            int bayID = (int)in.u32();
+            baysFit = baysFit && bays.canServe(bayID, treating.back().first) &&
+                      usedBays.insert(bayID).second;
+            loaded.treatmentBayIDs.push_back(bayID);
+        }
+        if (!in.ok || in.position != mapped.size - 8) {
+            error = "snapshot is truncated";
+            return false;
+        }
+        if (!baysFit) {
+            error = "snapshot bays do not match this department's treatment bays";
+            return false;
+        }
+        if (!caseIDsUnique(caseIDs, loaded.nextCaseID, error)) {
+            return false;
+        }
+        for (size_t i = 1; i < priorities.size(); i++) {
+            if (priorities[(i - 1) / arity] < priorities[i]) {
+                error = "pending cases are not in heap order";
+                return false;
+            }
+        }
+
+        // Decode straight into the heap's storage. The order was checked
+        // above, so a rebuild here means the two checks disagree.
+        Reader records(mapped.data, mapped.size);
+        records.position = pendingStart;
+        if (!pending.restoreHeapOrder((int)pendingCount, [&records]() {
+                EmergencyCase c;
+                readCase(records, c);
+                return c;
+            })) {
+            error = "heap order could not be restored";
+            return false;
+        }
+        board.clear();
+        for (size_t i = 0; i < treating.size(); i++) {
+            board.admit(treating[i].first, treating[i].second);
+        }
+        state = loaded;
+        return true;
+    }
+
+private:
+    static const char* magic() {
+        return "EDSNAP01";
+    }
+
+    static void putU32(string& out, uint32_t value) {
+        out.append(reinterpret_cast<const char*>(&value), 4);
+    }
+
+    static void putU64(string& out, uint64_t value) {
+        out.append(reinterpret_cast<const char*>(&value), 8);
+    }
+
+    static void putString(string& out, const string& text) {
+        putU32(out, (uint32_t)text.size());
+        out.append(text);
+    }
+
+    static void putCase(string& out, const EmergencyCase& c) {
+        putU32(out, (uint32_t)c.caseID);
+        putU32(out, (uint32_t)c.priorityLevel);
+        putU64(out, (uint64_t)(int64_t)c.arrivalTimeRaw);
+        putString(out, c.patientName);
+        putString(out, c.emergencyType);
+        putString(out, c.arrivalTime);
+        putString(out, c.additionalNotes);
+    }
+
+    // FNV-1a taken a 64-bit word at a time (tail bytes one by one); the
+    // byte-wise loop was the single largest cost of a 10^6-case restore
+    static uint64_t fnv1a(const char* data, size_t size) {
+        uint64_t hash = 1469598103934665603ULL;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            hash ^= word;
+            hash *= 1099511628211ULL;
+        }
+        for (; i < size; i++) {
+            hash ^= (unsigned char)data[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // Bounds-checked cursor over the mapped bytes
+    struct Reader {
+        const char* data;
+        size_t size;
+        size_t position;
+        bool ok;
+
+        Reader(const char* d, size_t s) : data(d), size(s), position(0), ok(true) {}
+
+        bool has(size_t bytes) {
+            if (!ok || size - position < bytes) {
+                ok = false;
+            }
+            return ok;
+        }
+
+        void skip(size_t bytes) {
+            if (has(bytes)) position += bytes;
+        }
+
+        uint32_t u32() {
+            uint32_t value = 0;
+            if (has(4)) {
+                memcpy(&value, data + position, 4);
+                position += 4;
+            }
+            return value;
+        }
+
+        uint64_t u64() {
+            uint64_t value = 0;
+            if (has(8)) {
+                memcpy(&value, data + position, 8);
+                position += 8;
+            }
+            return value;
+        }
+
+        string str() {
+            uint32_t length = u32();
+            if (!has(length)) return string();
+            string text(data + position, length);
+            position += length;
+            return text;
+        }
+    };
+
+    static void readCase(Reader& in, EmergencyCase& c) {
+        c.caseID = (int)in.u32();
+        c.priorityLevel = (int)in.u32();
+        c.arrivalTimeRaw = (time_t)(int64_t)in.u64();
+        c.patientName = in.str();
+        c.emergencyType = in.str();
+        c.arrivalTime = in.str();
+        c.additionalNotes = in.str();
+    }
+
+    // Every ID must be below nextCaseID and appear once across the pending,
+    // waiting and treatment sections. IDs are handed out in sequence, so a
+    // bitmap over [lowest, nextCaseID) is usually small; a sparse range
+    // falls back to sorting.
+    static bool caseIDsUnique(vector<int>& caseIDs, int nextCaseID, string& error) {
+        if (caseIDs.empty()) return true;
+        int lowest = *min_element(caseIDs.begin(), caseIDs.end());
+        int highest = *max_element(caseIDs.begin(), caseIDs.end());
+        if (highest >= nextCaseID) {
+            error = "snapshot holds case " + to_string(highest) +
+                    " but its next case ID is " + to_string(nextCaseID);
+            return false;
+        }
+        long long span = (long long)highest - lowest + 1;
+        bool duplicate = false;
+        if (span <= (long long)caseIDs.size() * 64 + 4096) {
+            vector<bool> seen((size_t)span, false);
+            for (size_t i = 0; i < caseIDs.size() && !duplicate; i++) {
+                size_t bit = (size_t)((long long)caseIDs[i] - lowest);
+                duplicate = seen[bit];
+                seen[bit] = true;
+            }
+        } else {
+            sort(caseIDs.begin(), caseIDs.end());
+            duplicate = adjacent_find(caseIDs.begin(), caseIDs.end()) != caseIDs.end();
+        }
+        if (duplicate) {
+            error = "snapshot lists a case more than once";
+            return false;
+        }
+        return true;
+    }
+
+    // Step over a case record, returning its priority (and its ID)
+    static int skipCase(Reader& in, int& caseID) {
+        caseID = (int)in.u32();
+        int priority = (int)in.u32();
+        in.skip(8);
+        for (int field = 0; field < 4; field++) {
+            in.skip(in.u32());
+        }
+        return priority;
+    }
+
+    // Read-only view of a whole file: mmap where available, else a buffer
+    struct MappedFile {
+        const char* data;
+        size_t size;
+#ifndef _WIN32
+        void* mapping;
+#endif
+        vector<char> buffer;
+
+        MappedFile() : data(nullptr), size(0) {
+#ifndef _WIN32
+            mapping = nullptr;
+#endif
+        }
+
+        ~MappedFile() {
+#ifndef _WIN32
+            if (mapping != nullptr) munmap(mapping, size);
+#endif
+        }
+
+        bool open(const string& path) {
+#ifndef _WIN32
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat info;
+            if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+                close(fd);
+                return false;
+            }
+            size = (size_t)info.st_size;
+            mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                return false;
+            }
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+            return true;
+#else
+            FILE* file = fopen(path.c_str(), "rb");
+            if (file == nullptr) return false;
+            fseek(file, 0, SEEK_END);
+            long length = ftell(file);
+            fseek(file, 0, SEEK_SET);
+            if (length <= 0) {
+                fclose(file);
+                return false;
+            }
+            buffer.resize((size_t)length);
+            size = fread(&buffer[0], 1, buffer.size(), file);
+            fclose(file);
+            data = &buffer[0];
+            return size == buffer.size();
+#endif
+        }
+    };
+};
+
+#endif // ED_SNAPSHOT_HPP
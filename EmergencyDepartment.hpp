@@ -5,6 +5,25 @@
 #include <string>
 #include <iomanip>
 #include <ctime>
+#include <vector>
+#include <unordered_map>
+#include <map>
+#include <set>
+#include <cctype>
+#include <utility>
+#include <stdexcept>
+#include <iterator>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <algorithm>
+#include "PriorityQueue.hpp"
+#include "OpStatus.hpp"
+#include "SlaTimingWheel.hpp"
+#include "EventBus.hpp"
+#include "Instrumentation.hpp"
 
 using namespace std;
 
@@ -15,14 +34,17 @@ struct EmergencyCase {
     int priorityLevel;             
     string arrivalTime;            
     string additionalNotes;        
+    time_t arrivalTimeRaw;         // raw arrival timestamp for SLA deadlines
     
     EmergencyCase() : caseID(0), patientName(""), emergencyType(""), 
-                      priorityLevel(0), arrivalTime(""), additionalNotes("") {}
+                      priorityLevel(0), arrivalTime(""), additionalNotes(""),
+                      arrivalTimeRaw(0) {}
     
     EmergencyCase(int id, string name, string type, int priority, string notes = "") 
         : caseID(id), patientName(name), emergencyType(type), 
           priorityLevel(priority), additionalNotes(notes) {
         time_t now = time(0);
+        arrivalTimeRaw = now;
         arrivalTime = string(ctime(&now));
         if (!arrivalTime.empty() && arrivalTime.back() == '\n') {
             arrivalTime.pop_back();
@@ -30,170 +52,261 @@ struct EmergencyCase {
     }
 };
 
-class EmergencyPriorityQueue {
+// Per-priority case counts, updated on every insert/remove so that
+// dashboard figures never need to walk the cases themselves
+struct PriorityHistogram {
+    static const int MAX_PRIORITY = 10;
+
+    int countByPriority[MAX_PRIORITY + 1];   // index 1-10, slot 0 unused
+    int criticalCount;                       // Priority 8-10
+    int urgentCount;                         // Priority 5-7
+    int standardCount;                       // Priority 1-4
+    int total;
+
+    PriorityHistogram() {
+        clear();
+    }
+
+    void clear() {
+        for (int p = 0; p <= MAX_PRIORITY; p++) {
+            countByPriority[p] = 0;
+        }
+        criticalCount = 0;
+        urgentCount = 0;
+        standardCount = 0;
+        total = 0;
+    }
+
+    void add(int priority) {
+        adjust(priority, 1);
+    }
+
+    void remove(int priority) {
+        adjust(priority, -1);
+    }
+
+    int countAt(int priority) const {
+        if (priority < 0 || priority > MAX_PRIORITY) return 0;
+        return countByPriority[priority];
+    }
+
 private:
-    EmergencyCase* heap;           
-    int capacity;                
-    int currentSize;               
-    
-    // Get parent of current index
-    int getParentIndex(int index) {
-        return (index - 1) / 2;
+    void adjust(int priority, int delta) {
+        if (priority < 0) priority = 0;
+        if (priority > MAX_PRIORITY) priority = MAX_PRIORITY;
+
+        countByPriority[priority] += delta;
+        total += delta;
+
+        if (priority >= 8) {
+            criticalCount += delta;
+        } else if (priority >= 5) {
+            urgentCount += delta;
+        } else {
+            standardCount += delta;
+        }
     }
-    
-    // Get left child for current index
-    int getLeftChildIndex(int index) {
-        return (2 * index) + 1;
+};
+
+// Ordering key for the pending-case heap
+struct CasePriorityKey {
+    int operator()(const EmergencyCase& c) const {
+        return c.priorityLevel;
     }
-    
-    // Get right child for current index
-    int getRightChildIndex(int index) {
-        return (2 * index) + 2;
+};
+
+// Keeps caseID -> heap index in step with every move inside the heap
+struct CasePositionTracker {
+    unordered_map<int, int> positionByCaseID;
+
+    void moved(const EmergencyCase& c, size_t index) {
+        positionByCaseID[c.caseID] = (int)index;
+    }
+
+    void removed(const EmergencyCase& c) {
+        positionByCaseID.erase(c.caseID);
+    }
+
+    void clear() {
+        positionByCaseID.clear();
     }
+};
+
+// 4-ary max-heap on priorityLevel. Cases sit in a stable pool and the heap
+// orders slot numbers, so sifting never moves strings; this was the fastest
+// layout in bench/PriorityQueueMatrixBench for the ED case mix.
+typedef PriorityQueue<EmergencyCase, CasePriorityKey, less<int>, 4,
+                      IndirectStorage, CasePositionTracker> EmergencyCaseHeap;
+
+class EmergencyPriorityQueue {
+private:
+    EmergencyCaseHeap heap;
+    PriorityHistogram histogram;   // kept in step with the heap contents
     
-    // Helper function to check if node has left child
-    bool hasLeftChild(int index) {
-        return getLeftChildIndex(index) < currentSize;
+public:
+    EmergencyPriorityQueue(int initialCapacity = 10)
+        : heap(initialCapacity > 0 ? (size_t)initialCapacity : 1) {}
+    
+    // Check if queue is empty
+    bool isEmpty() {
+        return heap.empty();
     }
     
-    // Helper function to check if node has right child
-    bool hasRightChild(int index) {
-        return getRightChildIndex(index) < currentSize;
+    // Check if queue is full (the next insert grows the heap)
+    bool isFull() {
+        return heap.size() == heap.capacity();
     }
     
-    // Helper function to check if node has parent
-    bool hasParent(int index) {
-        return getParentIndex(index) >= 0;
+    // Get current size
+    int getSize() {
+        return (int)heap.size();
     }
     
-    // Helper function to swap two elements
-    void swap(int index1, int index2) {
-        EmergencyCase temp = heap[index1];
-        heap[index1] = heap[index2];
-        heap[index2] = temp;
+    // Get allocated capacity
+    int getCapacity() {
+        return (int)heap.capacity();
     }
     
-    // Heapify up (bubble up) - used after insertion
-    void heapifyUp(int index) {
-        // Continue while the node has a parent and violates heap property
-        while (hasParent(index) && 
-               heap[getParentIndex(index)].priorityLevel < heap[index].priorityLevel) {
-            // Swap with parent
-            swap(getParentIndex(index), index);
-            // Move up to parent's position
-            index = getParentIndex(index);
-        }
+    // Cases the heap's storage currently holds memory for
+    int getElementCapacity() {
+        return (int)heap.elementCapacity();
     }
     
-    // Heapify down (bubble down) - used after deletion
-    void heapifyDown(int index) {
-        while (hasLeftChild(index)) {
-            // Find the child with higher priority
-            int largerChildIndex = getLeftChildIndex(index);
-            
-            // Check if right child exists and has higher priority
-            if (hasRightChild(index) && 
-                heap[getRightChildIndex(index)].priorityLevel > heap[largerChildIndex].priorityLevel) {
-                largerChildIndex = getRightChildIndex(index);
-            }
-            
-            // If current node has higher or equal priority than both children, stop
-            if (heap[index].priorityLevel >= heap[largerChildIndex].priorityLevel) {
-                break;
-            }
-            
-            // Swap with the larger child
-            swap(index, largerChildIndex);
-            // Move down to child's position
-            index = largerChildIndex;
-        }
+    // O(1) counts by priority band
+    int getCriticalCount() {
+        return histogram.criticalCount;
     }
     
-    void resizeHeap() {
-        int newCapacity = capacity * 2;
-        EmergencyCase* newHeap = new EmergencyCase[newCapacity];
-        
-        // Copy existing elements
-        for (int i = 0; i < currentSize; i++) {
-            newHeap[i] = heap[i];
-        }
-        
-        // Delete old heap and update pointers
-        delete[] heap;
-        heap = newHeap;
-        capacity = newCapacity;
-        
-        cout << "\nHeap capacity expanded to " << capacity << " to accommodate more cases.\n";
+    int getUrgentCount() {
+        return histogram.urgentCount;
     }
     
-public:
-    EmergencyPriorityQueue(int initialCapacity = 10) {
-        capacity = initialCapacity;
-        currentSize = 0;
-        heap = new EmergencyCase[capacity];
+    int getStandardCount() {
+        return histogram.standardCount;
     }
     
-    ~EmergencyPriorityQueue() {
-        delete[] heap;
+    int getCountAtPriority(int priority) {
+        return histogram.countAt(priority);
     }
     
-    // Check if queue is empty
-    bool isEmpty() {
-        return currentSize == 0;
+    // Percentage of the allocated heap currently in use
+    double getUtilization() {
+        return heap.capacity() == 0 ? 0.0 : (heap.size() * 100.0 / heap.capacity());
     }
     
-    // Check if queue is full
-    bool isFull() {
-        return currentSize == capacity;
+    // Any pending case with priority 8-10
+    bool hasCriticalCases() {
+        return histogram.criticalCount > 0;
     }
     
-    // Get current size
-    int getSize() {
-        return currentSize;
+    // Pre-size the heap before an expected surge so inserts do not pay for
+    // growth. The reservation is held until the queue reaches half of it.
+    void reserve(int expectedCases) {
+        if (expectedCases > 0) {
+            heap.reserve((size_t)expectedCases);
+            heap.getTracker().positionByCaseID.reserve((size_t)expectedCases);
+        }
     }
     
     // Insert a new emergency case 
     void insertEmergencyCase(EmergencyCase newCase) {
-        // Check if resize is needed
-        if (isFull()) {
-            resizeHeap();
+        HOSPITAL_TIMED(METRIC_INSERT_CASE);
+        histogram.add(newCase.priorityLevel);
+        heap.push(std::move(newCase));
+    }
+    
+    // Insert a whole batch of cases (e.g. a transfer from another facility)
+    // - empty heap: bottom-up (Floyd) heap construction, O(n)
+    // - non-empty heap: append and rebuild when the batch is large relative
+    //   to the heap, otherwise bubble each new case up
+    template <typename Iterator>
+    void insertBatch(Iterator first, Iterator last) {
+        for (Iterator it = first; it != last; ++it) {
+            histogram.add(it->priorityLevel);
         }
-        
-        // Add new element at the end
-        heap[currentSize] = newCase;
-        currentSize++;
-        
-        // Restore heap property by bubbling up
-        heapifyUp(currentSize - 1);
+        heap.pushBatch(first, last);
     }
     
     // Remove and return the highest priority case (Dequeue)
     EmergencyCase extractMostCritical() {
+        HOSPITAL_TIMED(METRIC_EXTRACT_CASE);
         if (isEmpty()) {
             throw runtime_error("Cannot extract from empty priority queue!");
         }
         
-        // Store the root (highest priority element)
-        EmergencyCase mostCritical = heap[0];
-        
-        // Move last element to root
-        heap[0] = heap[currentSize - 1];
-        currentSize--;
-        
-        // Restore heap property by bubbling down
-        if (currentSize > 0) {
-            heapifyDown(0);
-        }
-        
+        // Memory is handed back by the heap's shrink policy after a surge
+        EmergencyCase mostCritical = heap.pop();
+        histogram.remove(mostCritical.priorityLevel);
         return mostCritical;
     }
     
+    // Replace the contents with count cases produced by next() in raw heap
+    // order (snapshot restore). No re-heapify unless the order is invalid.
+    template <typename Source>
+    bool restoreHeapOrder(int count, Source next) {
+        histogram.clear();
+        heap.getTracker().positionByCaseID.reserve((size_t)count);
+        PriorityHistogram& counts = histogram;
+        return heap.assignHeapOrder((size_t)count, [&counts, &next]() {
+            EmergencyCase c = next();
+            counts.add(c.priorityLevel);
+            return c;
+        });
+    }
+    
+    // Raw heap-order access, index 0 is the most critical case
+    const EmergencyCase& caseAt(int heapIndex) {
+        return heap.at((size_t)heapIndex);
+    }
+    
+    static unsigned getHeapArity() {
+        return EmergencyCaseHeap::arity();
+    }
+    
     // Peek at the highest priority case without removing it
     EmergencyCase peekMostCritical() {
-        if (isEmpty()) {
-            throw runtime_error("Priority queue is empty!");
+        return heap.top();
+    }
+    
+    // O(1) lookup of a pending case by ID, nullptr if not pending
+    const EmergencyCase* findCase(int caseID) {
+        const unordered_map<int, int>& positions = heap.getTracker().positionByCaseID;
+        unordered_map<int, int>::const_iterator it = positions.find(caseID);
+        if (it == positions.end()) return nullptr;
+        return &heap.at(it->second);
+    }
+    
+    // Queue rank of a pending case (1 = next to be processed), computed from
+    // the priority histogram instead of sorting. Cases sharing a priority are
+    // served in heap order, so the rank is the best position within that
+    // tie; tiedWith receives the number of other cases at the same priority.
+    int getRank(int caseID, int* tiedWith = nullptr) {
+        const EmergencyCase* pending = findCase(caseID);
+        if (pending == nullptr) return -1;
+        
+        int ahead = 0;
+        for (int p = PriorityHistogram::MAX_PRIORITY; p > pending->priorityLevel; p--) {
+            ahead += histogram.countAt(p);
+        }
+        if (tiedWith != nullptr) {
+            *tiedWith = histogram.countAt(pending->priorityLevel) - 1;
+        }
+        return ahead + 1;
+    }
+    
+    // Copy of the pending cases, most critical first, earlier Case ID first
+    // within a priority (the heap itself leaves ties unordered)
+    vector<EmergencyCase> casesInPriorityOrder() {
+        vector<EmergencyCase> cases;
+        cases.reserve(heap.size());
+        for (size_t i = 0; i < heap.size(); i++) {
+            cases.push_back(heap.at(i));
         }
-        return heap[0];
+        sort(cases.begin(), cases.end(), [](const EmergencyCase& a, const EmergencyCase& b) {
+            if (a.priorityLevel != b.priorityLevel) return a.priorityLevel > b.priorityLevel;
+            return a.caseID < b.caseID;
+        });
+        return cases;
     }
     
     // Display all emergency cases in priority order (without modifying heap)
@@ -203,22 +316,8 @@ public:
             return;
         }
         
-        // Create a temporary copy of the heap for sorting
-        EmergencyCase* tempArray = new EmergencyCase[currentSize];
-        for (int i = 0; i < currentSize; i++) {
-            tempArray[i] = heap[i];
-        }
-        
-        // Sort the temporary array by priority (bubble sort for simplicity)
-        for (int i = 0; i < currentSize - 1; i++) {
-            for (int j = 0; j < currentSize - i - 1; j++) {
-                if (tempArray[j].priorityLevel < tempArray[j + 1].priorityLevel) {
-                    EmergencyCase temp = tempArray[j];
-                    tempArray[j] = tempArray[j + 1];
-                    tempArray[j + 1] = temp;
-                }
-            }
-        }
+        int currentSize = getSize();
+        vector<EmergencyCase> sortedCases = casesInPriorityOrder();
         
         // Display sorted cases
         cout << "\n========================================";
@@ -232,20 +331,18 @@ public:
         cout << string(95, '-') << endl;
         
         for (int i = 0; i < currentSize; i++) {
-            cout << left << setw(10) << tempArray[i].caseID
-                 << setw(25) << tempArray[i].patientName
-                 << setw(20) << tempArray[i].emergencyType
-                 << setw(10) << tempArray[i].priorityLevel
-                 << setw(30) << tempArray[i].arrivalTime << endl;
+            cout << left << setw(10) << sortedCases[i].caseID
+                 << setw(25) << sortedCases[i].patientName
+                 << setw(20) << sortedCases[i].emergencyType
+                 << setw(10) << sortedCases[i].priorityLevel
+                 << setw(30) << sortedCases[i].arrivalTime << endl;
             
-            if (!tempArray[i].additionalNotes.empty()) {
-                cout << "  Notes: " << tempArray[i].additionalNotes << endl;
+            if (!sortedCases[i].additionalNotes.empty()) {
+                cout << "  Notes: " << sortedCases[i].additionalNotes << endl;
             }
         }
         cout << string(95, '=') << endl;
         cout << "Total Cases: " << currentSize << endl;
-        
-        delete[] tempArray;
     }
     
     // Get statistics about current emergency cases
@@ -255,27 +352,422 @@ public:
             return;
         }
         
-        int criticalCount = 0;     // Priority 8-10
-        int urgentCount = 0;       // Priority 5-7
-        int standardCount = 0;     // Priority 1-4
+        cout << "\n======== EMERGENCY DEPARTMENT STATISTICS ========\n";
+        cout << "Total Active Cases: " << getSize() << "/" << getCapacity() << endl;
+        cout << "Critical Cases (Priority 8-10): " << histogram.criticalCount << endl;
+        cout << "Urgent Cases (Priority 5-7): " << histogram.urgentCount << endl;
+        cout << "Standard Cases (Priority 1-4): " << histogram.standardCount << endl;
+        cout << "Queue Utilization: " << getUtilization() << "%\n";
+        cout << "=================================================\n";
+    }
+};
+
+// Stable reference to a case on the treatment board. The generation guards
+// against a handle outliving its case once the slot has been reused.
+struct TreatmentHandle {
+    int slot;
+    unsigned generation;
+
+    TreatmentHandle() : slot(-1), generation(0) {}
+    TreatmentHandle(int s, unsigned g) : slot(s), generation(g) {}
+
+    bool isValid() const {
+        return slot >= 0;
+    }
+};
+
+// Treatment board (slot map with free list)
+// - admit and complete are O(1); freed slots are reused, so memory follows
+//   the peak number of concurrent treatments rather than the all-time total
+// - occupied slots are also chained in treatment-start order for display
+class TreatmentBoard {
+private:
+    struct Slot {
+        EmergencyCase patientCase;
+        string startedAt;          // when treatment began
+        unsigned generation;
+        bool occupied;
+        int prev;                  // start-order chain (occupied slots)
+        int next;                  // start-order chain, or free list link
+    };
+    
+    vector<Slot> slots;
+    unordered_map<int, int> slotByCaseID;
+    int freeHead;                  // first free slot, -1 if none
+    int oldest;                    // head of start-order chain
+    int newest;                    // tail of start-order chain
+    int activeCount;
+    PriorityHistogram histogram;
+    
+    static string currentTimeText() {
+        time_t now = time(0);
+        string text = string(ctime(&now));
+        if (!text.empty() && text.back() == '\n') {
+            text.pop_back();
+        }
+        return text;
+    }
+    
+    void unlink(int index) {
+        Slot& s = slots[index];
+        if (s.prev != -1) slots[s.prev].next = s.next; else oldest = s.next;
+        if (s.next != -1) slots[s.next].prev = s.prev; else newest = s.prev;
+    }
+    
+    void releaseSlot(int index) {
+        Slot& s = slots[index];
+        unlink(index);
+        slotByCaseID.erase(s.patientCase.caseID);
+        histogram.remove(s.patientCase.priorityLevel);
         
-        for (int i = 0; i < currentSize; i++) {
-            if (heap[i].priorityLevel >= 8) {
-                criticalCount++;
-            } else if (heap[i].priorityLevel >= 5) {
-                urgentCount++;
-            } else {
-                standardCount++;
+        s.patientCase = EmergencyCase();   // drop string storage now
+        s.startedAt.clear();
+        s.occupied = false;
+        s.generation++;
+        s.prev = -1;
+        s.next = freeHead;
+        freeHead = index;
+        activeCount--;
+    }
+    
+public:
+    TreatmentBoard() : freeHead(-1), oldest(-1), newest(-1), activeCount(0) {}
+    
+    // Start treatment of a case, returns its handle (invalid if the case ID
+    // is already on the board)
+    TreatmentHandle admit(const EmergencyCase& patientCase, const string& startedAt = "") {
+        if (slotByCaseID.count(patientCase.caseID)) {
+            return TreatmentHandle();
+        }
+        
+        int index;
+        if (freeHead != -1) {
+            index = freeHead;
+            freeHead = slots[index].next;
+        } else {
+            index = (int)slots.size();
+            slots.push_back(Slot());
+            slots[index].generation = 0;
+        }
+        
+        Slot& s = slots[index];
+        s.patientCase = patientCase;
+        s.startedAt = startedAt.empty() ? currentTimeText() : startedAt;
+        s.occupied = true;
+        s.prev = newest;
+        s.next = -1;
+        
+        if (newest != -1) slots[newest].next = index; else oldest = index;
+        newest = index;
+        
+        slotByCaseID[patientCase.caseID] = index;
+        histogram.add(patientCase.priorityLevel);
+        activeCount++;
+        
+        return TreatmentHandle(index, s.generation);
+    }
+    
+    // Complete (discharge) a case by ID; copies it out if requested
+    bool complete(int caseID, EmergencyCase* discharged = nullptr) {
+        unordered_map<int, int>::iterator it = slotByCaseID.find(caseID);
+        if (it == slotByCaseID.end()) {
+            return false;
+        }
+        if (discharged != nullptr) {
+            *discharged = slots[it->second].patientCase;
+        }
+        releaseSlot(it->second);
+        return true;
+    }
+    
+    // Complete by handle; stale handles are rejected
+    bool complete(TreatmentHandle handle) {
+        if (get(handle) == nullptr) {
+            return false;
+        }
+        releaseSlot(handle.slot);
+        return true;
+    }
+    
+    const EmergencyCase* get(TreatmentHandle handle) const {
+        if (handle.slot < 0 || handle.slot >= (int)slots.size()) return nullptr;
+        const Slot& s = slots[handle.slot];
+        if (!s.occupied || s.generation != handle.generation) return nullptr;
+        return &s.patientCase;
+    }
+    
+    const EmergencyCase* findByCaseID(int caseID) const {
+        unordered_map<int, int>::const_iterator it = slotByCaseID.find(caseID);
+        if (it == slotByCaseID.end()) return nullptr;
+        return &slots[it->second].patientCase;
+    }
+    
+    // Visit cases in the order their treatment started
+    template <typename Visitor>
+    void forEachInStartOrder(Visitor visit) const {
+        for (int i = oldest; i != -1; i = slots[i].next) {
+            visit(slots[i].patientCase, slots[i].startedAt);
+        }
+    }
+    
+    void clear() {
+        vector<Slot>().swap(slots);
+        slotByCaseID.clear();
+        freeHead = oldest = newest = -1;
+        activeCount = 0;
+        histogram.clear();
+    }
+    
+    int size() const {
+        return activeCount;
+    }
+    
+    bool isEmpty() const {
+        return activeCount == 0;
+    }
+    
+    // Slots allocated so far (peak concurrent treatments)
+    int getSlotCapacity() const {
+        return (int)slots.size();
+    }
+    
+    const PriorityHistogram& getHistogram() const {
+        return histogram;
+    }
+};
+
+// Bay capabilities, least to most capable. A bay can take any case whose
+// requirement is at or below its own capability.
+enum BayCapability {
+    BAY_GENERAL = 0,
+    BAY_TRAUMA = 1,
+    BAY_RESUS = 2
+};
+
+struct TreatmentBay {
+    int bayID;
+    BayCapability capability;
+    int occupantCaseID;            // -1 when free
+};
+
+// Treatment bay pool. Free bays sit in one ordered set per capability, so
+// finding the best free bay (least capable one that fits, lowest ID) and
+// taking it are O(log n). Called cases with no compatible free bay wait in
+// one priority queue per requirement; a freed bay goes to the highest-
+// priority case among the waitlists it can serve.
+class BayAllocator {
+public:
+    static const int CAPABILITY_COUNT = 3;
+    
+private:
+    vector<TreatmentBay> bays;
+    set<int> freeBays[CAPABILITY_COUNT];
+    EmergencyPriorityQueue waitlists[CAPABILITY_COUNT];
+    unordered_map<int, int> bayByCaseID;
+    int bayCount[CAPABILITY_COUNT];
+    
+    int takeFreeBay(BayCapability need) {
+        for (int cap = need; cap < CAPABILITY_COUNT; cap++) {
+            if (!freeBays[cap].empty()) {
+                int bayID = *freeBays[cap].begin();
+                freeBays[cap].erase(freeBays[cap].begin());
+                return bayID;
             }
         }
+        return -1;
+    }
+    
+    void occupy(int bayID, int caseID) {
+        bays[bayID].occupantCaseID = caseID;
+        bayByCaseID[caseID] = bayID;
+    }
+    
+public:
+    BayAllocator() {
+        for (int cap = 0; cap < CAPABILITY_COUNT; cap++) {
+            bayCount[cap] = 0;
+        }
+    }
+    
+    // Critical cases need resuscitation; injuries need a trauma bay
+    static BayCapability requiredCapability(const EmergencyCase& c) {
+        if (c.priorityLevel >= 8) return BAY_RESUS;
         
-        cout << "\n======== EMERGENCY DEPARTMENT STATISTICS ========\n";
-        cout << "Total Active Cases: " << currentSize << "/" << capacity << endl;
-        cout << "Critical Cases (Priority 8-10): " << criticalCount << endl;
-        cout << "Urgent Cases (Priority 5-7): " << urgentCount << endl;
-        cout << "Standard Cases (Priority 1-4): " << standardCount << endl;
-        cout << "Queue Utilization: " << (currentSize * 100.0 / capacity) << "%\n";
-        cout << "=================================================\n";
+        static const char* traumaTypes[] = { "trauma", "accident", "fracture", "burn", "injur", "wound" };
+        string type = c.emergencyType;
+        for (size_t i = 0; i < type.size(); i++) {
+            type[i] = (char)tolower((unsigned char)type[i]);
+        }
+        for (size_t i = 0; i < sizeof(traumaTypes) / sizeof(traumaTypes[0]); i++) {
+            if (type.find(traumaTypes[i]) != string::npos) return BAY_TRAUMA;
+        }
+        return BAY_GENERAL;
+    }
+    
+    static string capabilityName(BayCapability cap) {
+        switch (cap) {
+            case BAY_RESUS: return "Resus";
+            case BAY_TRAUMA: return "Trauma";
+            default: return "General";
+        }
+    }
+    
+    // Label shown on boards, e.g. "R1", "T3", "G12"
+    string bayLabel(int bayID) const {
+        if (bayID < 0 || bayID >= (int)bays.size()) return "-";
+        return capabilityName(bays[bayID].capability).substr(0, 1) + to_string(bayID + 1);
+    }
+    
+    int addBay(BayCapability cap) {
+        TreatmentBay bay;
+        bay.bayID = (int)bays.size();
+        bay.capability = cap;
+        bay.occupantCaseID = -1;
+        bays.push_back(bay);
+        freeBays[cap].insert(bay.bayID);
+        bayCount[cap]++;
+        return bay.bayID;
+    }
+    
+    // Put a case straight into the best free bay; -1 if none fits
+    int assign(const EmergencyCase& c) {
+        int bayID = takeFreeBay(requiredCapability(c));
+        if (bayID != -1) {
+            occupy(bayID, c.caseID);
+        }
+        return bayID;
+    }
+    
+    // Whether bayID exists and is capable enough for the case
+    bool canServe(int bayID, const EmergencyCase& c) const {
+        return bayID >= 0 && bayID < (int)bays.size() &&
+               bays[bayID].capability >= requiredCapability(c);
+    }
+    
+    // Put a case into one particular free bay (snapshot restore); false if
+    // the bay cannot serve it or is already taken
+    bool occupyBay(int bayID, const EmergencyCase& c) {
+        if (!canServe(bayID, c) || freeBays[bays[bayID].capability].erase(bayID) == 0) {
+            return false;
+        }
+        occupy(bayID, c.caseID);
+        return true;
+    }
+    
+    // Queue a case without trying the free bays (snapshot restore)
+    void addWaiting(const EmergencyCase& c) {
+        waitlists[requiredCapability(c)].insertEmergencyCase(c);
+    }
+    
+    // Assign a bay, or queue the case until a compatible bay frees up
+    int request(const EmergencyCase& c) {
+        int bayID = assign(c);
+        if (bayID == -1) {
+            waitlists[requiredCapability(c)].insertEmergencyCase(c);
+        }
+        return bayID;
+    }
+    
+    // Free the bay held by caseID and hand it to the highest-priority
+    // waiting case it can serve (ties go to the more demanding waitlist).
+    // Returns the bay the matched case now holds, or -1 if none was waiting.
+    int release(int caseID, EmergencyCase& matched) {
+        unordered_map<int, int>::iterator it = bayByCaseID.find(caseID);
+        if (it == bayByCaseID.end()) {
+            return -1;
+        }
+        int bayID = it->second;
+        bayByCaseID.erase(it);
+        bays[bayID].occupantCaseID = -1;
+        
+        int best = -1;
+        int bestPriority = 0;
+        for (int need = bays[bayID].capability; need >= 0; need--) {
+            if (waitlists[need].isEmpty()) continue;
+            int priority = waitlists[need].peekMostCritical().priorityLevel;
+            if (priority > bestPriority) {
+                best = need;
+                bestPriority = priority;
+            }
+        }
+        
+        if (best == -1) {
+            freeBays[bays[bayID].capability].insert(bayID);
+            return -1;
+        }
+        matched = waitlists[best].extractMostCritical();
+        occupy(bayID, matched.caseID);
+        return bayID;
+    }
+    
+    const TreatmentBay& getBay(int bayID) const {
+        return bays[bayID];
+    }
+    
+    int bayOf(int caseID) const {
+        unordered_map<int, int>::const_iterator it = bayByCaseID.find(caseID);
+        return it == bayByCaseID.end() ? -1 : it->second;
+    }
+    
+    const EmergencyCase* findWaiting(int caseID) {
+        for (int need = 0; need < CAPABILITY_COUNT; need++) {
+            const EmergencyCase* c = waitlists[need].findCase(caseID);
+            if (c != nullptr) return c;
+        }
+        return nullptr;
+    }
+    
+    // Visit every case waiting for a bay (heap order within each waitlist)
+    template <typename Visitor>
+    void forEachWaiting(Visitor visit) {
+        for (int need = CAPABILITY_COUNT - 1; need >= 0; need--) {
+            for (int i = 0; i < waitlists[need].getSize(); i++) {
+                visit(waitlists[need].caseAt(i));
+            }
+        }
+    }
+    
+    int getWaitingCount() {
+        int total = 0;
+        for (int need = 0; need < CAPABILITY_COUNT; need++) {
+            total += waitlists[need].getSize();
+        }
+        return total;
+    }
+    
+    int getWaitingCount(BayCapability need) {
+        return waitlists[need].getSize();
+    }
+    
+    int getBayCount(BayCapability cap) const {
+        return bayCount[cap];
+    }
+    
+    int getFreeCount(BayCapability cap) const {
+        return (int)freeBays[cap].size();
+    }
+    
+    int getTotalBays() const {
+        return (int)bays.size();
+    }
+    
+    int getOccupiedCount() const {
+        return (int)bayByCaseID.size();
+    }
+    
+    // Empty every bay and waitlist; the bays themselves stay configured
+    void clear() {
+        bayByCaseID.clear();
+        for (int cap = 0; cap < CAPABILITY_COUNT; cap++) {
+            freeBays[cap].clear();
+            while (!waitlists[cap].isEmpty()) {
+                waitlists[cap].extractMostCritical();
+            }
+        }
+        for (size_t i = 0; i < bays.size(); i++) {
+            bays[i].occupantCaseID = -1;
+            freeBays[bays[i].capability].insert(bays[i].bayID);
+        }
     }
 };
 
@@ -283,12 +775,123 @@ public:
 class EmergencyDepartmentOfficer {
 private:
     EmergencyPriorityQueue* priorityQueue;
-    EmergencyCase* casesBeingProcessed;
     int nextCaseID;
     string officerName;
     string departmentCode;
-    int processedCount; 
-    int maxProcessedCapacity;  
+    TreatmentBoard treatmentBoard;   // cases currently in treatment
+    multimap<string, int> nameIndex; // lower-case patient name -> caseID
+    bool nameIndexStale;             // rebuilt on the next search (after a restore)
+    SlaTimingWheel slaWheel;         // time-to-treatment deadlines of pending cases
+    int slaBreachCount;
+    BayAllocator treatmentBays;      // bays, and called cases waiting for one
+    EventBus* eventBus;              // optional; critical cases are published here
+    int dispatchThreshold;           // lowest priority that requests an ambulance
+    int dispatchMailbox;             // dispatch outcomes addressed to this officer
+    
+    // Target time-to-treatment for each priority band
+    static int slaTargetMinutes(int priority) {
+        if (priority >= 8) return 10;    // Critical
+        if (priority >= 5) return 30;    // Urgent
+        return 120;                      // Standard
+    }
+    
+    void scheduleSla(const EmergencyCase& c) {
+        slaWheel.schedule(c.caseID, c.priorityLevel,
+                          c.arrivalTimeRaw + slaTargetMinutes(c.priorityLevel) * 60);
+    }
+    
+    // Whole-string base-10 integer: rejects "", "5abc" and out-of-range text
+    static bool parseInteger(const string& text, long& value) {
+        if (text.empty()) return false;
+        char* end = nullptr;
+        errno = 0;
+        value = strtol(text.c_str(), &end, 10);
+        return errno == 0 && *end == '\0';
+    }
+    
+    static string toLowerCase(string text) {
+        for (size_t i = 0; i < text.size(); i++) {
+            text[i] = (char)tolower((unsigned char)text[i]);
+        }
+        return text;
+    }
+    
+    void indexName(const EmergencyCase& c) {
+        if (nameIndexStale) return;
+        nameIndex.insert(make_pair(toLowerCase(c.patientName), c.caseID));
+    }
+    
+    void unindexName(const EmergencyCase& c) {
+        if (nameIndexStale) return;
+        pair<multimap<string, int>::iterator, multimap<string, int>::iterator> range =
+            nameIndex.equal_range(toLowerCase(c.patientName));
+        for (multimap<string, int>::iterator it = range.first; it != range.second; ++it) {
+            if (it->second == c.caseID) {
+                nameIndex.erase(it);
+                return;
+            }
+        }
+    }
+    
+    void ensureNameIndex() {
+        if (!nameIndexStale) return;
+        nameIndexStale = false;
+        nameIndex.clear();
+        for (int i = 0; i < priorityQueue->getSize(); i++) {
+            indexName(priorityQueue->caseAt(i));
+        }
+        treatmentBoard.forEachInStartOrder([this](const EmergencyCase& c, const string&) {
+            indexName(c);
+        });
+        treatmentBays.forEachWaiting([this](const EmergencyCase& c) {
+            indexName(c);
+        });
+    }
+    
+    // Ask the dispatch side for an ambulance; true if anyone was listening
+    bool publishIfCritical(const EmergencyCase& c) {
+        if (eventBus == nullptr || c.priorityLevel < dispatchThreshold) return false;
+        HospitalEvent event;
+        event.type = EVENT_CRITICAL_CASE_LOGGED;
+        event.caseID = c.caseID;
+        event.priority = c.priorityLevel;
+        event.patientName = c.patientName;
+        event.emergencyType = c.emergencyType;
+        event.loggedNs = EventBus::nowNs();
+        return eventBus->publish(event) > 0;
+    }
+    
+    // Print one search hit with its current state
+    void printSearchResult(int caseID) {
+        const EmergencyCase* c = priorityQueue->findCase(caseID);
+        string state;
+        string rankText = "-";
+        
+        if (c != nullptr) {
+            int tiedWith = 0;
+            int rank = priorityQueue->getRank(caseID, &tiedWith);
+            state = "Pending";
+            rankText = to_string(rank) + "/" + to_string(priorityQueue->getSize());
+            if (tiedWith > 0) {
+                rankText += " (+" + to_string(tiedWith) + " tied)";
+            }
+        } else if ((c = treatmentBays.findWaiting(caseID)) != nullptr) {
+            state = "Awaiting Bay";
+            rankText = "needs " + BayAllocator::capabilityName(BayAllocator::requiredCapability(*c));
+        } else {
+            c = treatmentBoard.findByCaseID(caseID);
+            if (c == nullptr) return;
+            state = "In Treatment";
+            rankText = "bay " + treatmentBays.bayLabel(treatmentBays.bayOf(caseID));
+        }
+        
+        cout << left << setw(10) << c->caseID
+             << setw(25) << c->patientName
+             << setw(20) << c->emergencyType
+             << setw(10) << c->priorityLevel
+             << setw(15) << state
+             << setw(20) << rankText << endl;
+    }
     
 public:
     // Constructor
@@ -297,16 +900,107 @@ public:
         nextCaseID = 1001;  // Starting case ID
         officerName = name;
         departmentCode = code;
-
-        maxProcessedCapacity = 20; 
-        casesBeingProcessed = new EmergencyCase[maxProcessedCapacity];
-        processedCount = 0;
+        slaBreachCount = 0;
+        nameIndexStale = false;
+        eventBus = nullptr;
+        dispatchThreshold = 8;
+        dispatchMailbox = -1;
+        
+        // Default floor plan: 2 resus, 4 trauma, 14 general bays
+        for (int i = 0; i < 2; i++) treatmentBays.addBay(BAY_RESUS);
+        for (int i = 0; i < 4; i++) treatmentBays.addBay(BAY_TRAUMA);
+        for (int i = 0; i < 14; i++) treatmentBays.addBay(BAY_GENERAL);
     }
     
     // Destructor
     ~EmergencyDepartmentOfficer() {
         delete priorityQueue;
-        delete[] casesBeingProcessed; 
+    }
+    
+    // Publish cases at or above `threshold` as EVENT_CRITICAL_CASE_LOGGED and,
+    // with `listen`, collect the dispatch outcomes for showDispatchNotices.
+    // The bus must outlive the officer.
+    void attachEventBus(EventBus* bus, int threshold = 8, bool listen = true) {
+        eventBus = bus;
+        dispatchThreshold = threshold;
+        if (listen) {
+            dispatchMailbox = bus->subscribe(EventBus::maskOf(EVENT_AMBULANCE_ASSIGNED) |
+                                             EventBus::maskOf(EVENT_DISPATCH_FAILED));
+        }
+    }
+    
+    void setDispatchThreshold(int threshold) {
+        dispatchThreshold = threshold;
+    }
+    
+    int getDispatchThreshold() const {
+        return dispatchThreshold;
+    }
+    
+    // ---- Core API: no console I/O ----
+    
+    // Log a case (name, type, priority 1-10, notes and arrival time as
+    // constructed; the Case ID is assigned here and reported in *caseID)
+    OpStatus logCase(EmergencyCase&& newCase, int* caseID = nullptr) {
+        if (newCase.patientName.empty() || newCase.emergencyType.empty() ||
+            newCase.priorityLevel < 1 || newCase.priorityLevel > 10) {
+            return OP_INVALID_ARGUMENT;
+        }
+        newCase.caseID = nextCaseID++;
+        if (caseID != nullptr) *caseID = newCase.caseID;
+        indexName(newCase);
+        scheduleSla(newCase);
+        publishIfCritical(newCase);
+        priorityQueue->insertEmergencyCase(std::move(newCase));
+        return OP_OK;
+    }
+    
+    // Call the most critical pending case into a bay; bayID is -1 when it has
+    // to wait for a compatible bay
+    OpStatus callNextCase(EmergencyCase& called, int& bayID) {
+        if (priorityQueue->isEmpty()) return OP_EMPTY;
+        called = priorityQueue->extractMostCritical();
+        bayID = treatmentBays.request(called);
+        if (bayID != -1) {
+            slaWheel.cancel(called.caseID);
+            treatmentBoard.admit(called);
+        }
+        return OP_OK;
+    }
+    
+    // Discharge a case in treatment. The freed bay goes straight to the best
+    // waiting case it can serve; reassignedCaseID is that case, or -1.
+    OpStatus finishCase(int caseID, EmergencyCase& discharged, int& reassignedCaseID) {
+        if (!treatmentBoard.complete(caseID, &discharged)) return OP_NOT_FOUND;
+        unindexName(discharged);
+        
+        EmergencyCase next;
+        reassignedCaseID = -1;
+        if (treatmentBays.release(discharged.caseID, next) != -1) {
+            slaWheel.cancel(next.caseID);
+            treatmentBoard.admit(next);
+            reassignedCaseID = next.caseID;
+        }
+        return OP_OK;
+    }
+    
+    int getPendingCount() const { return priorityQueue->getSize(); }
+    int getInTreatmentCount() const { return treatmentBoard.size(); }
+    string bayLabel(int bayID) const { return treatmentBays.bayLabel(bayID); }
+    
+    // Print the dispatch outcomes that arrived since the last call
+    void showDispatchNotices() {
+        if (eventBus == nullptr || dispatchMailbox == -1) return;
+        HospitalEvent event;
+        while (eventBus->pollNext(dispatchMailbox, event)) {
+            if (event.type == EVENT_AMBULANCE_ASSIGNED) {
+                cout << "[DISPATCH] Ambulance " << event.ambulanceID << " assigned to case #"
+                     << event.caseID << " (" << event.patientName << ")\n";
+            } else {
+                cout << "[DISPATCH] No ambulance available for case #" << event.caseID
+                     << " (" << event.patientName << ") - dispatch manually!\n";
+            }
+        }
     }
     
     //  Log Emergency Case
@@ -353,14 +1047,18 @@ public:
     getline(cin, notes);
     
     // Create and insert the emergency case
-    EmergencyCase newCase(nextCaseID++, patientName, emergencyType, priority, notes);
-    priorityQueue->insertEmergencyCase(newCase);
+    int caseID = 0;
+    OpStatus status = logCase(EmergencyCase(0, patientName, emergencyType, priority, notes), &caseID);
+    if (status != OP_OK) {
+        cout << "\nEmergency case could not be logged: " << opStatusText(status) << ".\n";
+        return;
+    }
     
     cout << "\nEmergency case logged successfully!\n";
-    cout << "Case ID: " << newCase.caseID << endl;
+    cout << "Case ID: " << caseID << endl;
     cout << "Patient Name: " << patientName << endl;
     cout << "Emergency Type: " << emergencyType << endl;
-    cout << "Priority Level: " << newCase.priorityLevel << endl;
+    cout << "Priority Level: " << priority << endl;
     
     if (priority >= 8) {
         cout << "\n[ALERT] CRITICAL CASE - Immediate attention required!\n";
@@ -369,6 +1067,9 @@ public:
     } else{
         cout << "\n[STANDARD] STANDARD CASE - Standard case logged.\n";
     }
+    if (eventBus != nullptr && priority >= dispatchThreshold) {
+        cout << "[DISPATCH] Ambulance requested automatically.\n";
+    }
 }
     
     // Process Most Critical Case
@@ -402,20 +1103,28 @@ public:
             
             if (confirm == 'Y' || confirm == 'y') {
                 // Extract the case from queue
-                EmergencyCase processedCase = priorityQueue->extractMostCritical();
+                EmergencyCase processedCase;
+                int bayID = -1;
+                callNextCase(processedCase, bayID);
                 
-                if (processedCount < maxProcessedCapacity) {
-                    casesBeingProcessed[processedCount] = processedCase;
-                    processedCount++;
-                }
                 cout << "\nCase #" << processedCase.caseID 
                      << " has been processed and removed from queue.\n";
-                cout << "Patient " << processedCase.patientName 
-                     << " is being attended to by medical staff.\n";
+                if (bayID != -1) {
+                    cout << "Patient " << processedCase.patientName 
+                         << " is being attended to by medical staff in bay "
+                         << treatmentBays.bayLabel(bayID) << ".\n";
+                } else {
+                    // SLA keeps running until the patient is actually in a bay
+                    BayCapability need = BayAllocator::requiredCapability(processedCase);
+                    cout << "No free " << BayAllocator::capabilityName(need)
+                         << "-capable bay. Patient " << processedCase.patientName
+                         << " is waiting for the next compatible bay ("
+                         << treatmentBays.getWaitingCount(need) << " waiting).\n";
+                }
                 
                 // Show remaining cases count
                 cout << "Remaining cases in queue: " << priorityQueue->getSize() << endl;
-                cout << "Cases currently being processed: " << processedCount << endl;  
+                cout << "Cases currently being processed: " << treatmentBoard.size() << endl;  
 
             } else {
                 cout << "Case processing cancelled.\n";
@@ -428,23 +1137,11 @@ public:
     void viewCasesBeingProcessed() {
         cout << "\n===== CASES CURRENTLY BEING PROCESSED =====\n";
         
-        if (processedCount == 0) {
+        if (treatmentBoard.isEmpty()) {
             cout << "\nNo cases are currently being processed.\n";
+            displayBayStatus();
             return;
         }
-        int criticalCount = 0;     // Priority 8-10
-        int urgentCount = 0;       // Priority 5-7
-        int standardCount = 0;     // Priority 1-4
-        
-        for (int i = 0; i < processedCount; i++) {
-            if (casesBeingProcessed[i].priorityLevel >= 8) {
-                criticalCount++;
-            } else if (casesBeingProcessed[i].priorityLevel >= 5) {
-                urgentCount++;
-            } else {
-                standardCount++;
-            }
-        }
         
         cout << "\n========================================";
         cout << " CASES IN TREATMENT ";
@@ -453,26 +1150,259 @@ public:
              << setw(25) << "Patient Name"
              << setw(20) << "Emergency Type"
              << setw(10) << "Priority"
+             << setw(8) << "Bay"
              << setw(30) << "Started Processing" << endl;
-        cout << string(95, '-') << endl;
+        cout << string(103, '-') << endl;
+        
+        treatmentBoard.forEachInStartOrder(
+            [this](const EmergencyCase& c, const string& startedAt) {
+                cout << left << setw(10) << c.caseID
+                     << setw(25) << c.patientName
+                     << setw(20) << c.emergencyType
+                     << setw(10) << c.priorityLevel
+                     << setw(8) << treatmentBays.bayLabel(treatmentBays.bayOf(c.caseID))
+                     << setw(30) << startedAt << endl;
+                
+                if (!c.additionalNotes.empty()) {
+                    cout << "  Notes: " << c.additionalNotes << endl;
+                }
+            });
+        
+        const PriorityHistogram& counts = treatmentBoard.getHistogram();
+        cout << string(103, '=') << endl;
+        cout << "Total Cases Being Processed: " << treatmentBoard.size() << endl;
+        cout << "Critical Cases (Priority 8-10): " << counts.criticalCount << endl;
+        cout << "Urgent Cases (Priority 5-7): " << counts.urgentCount << endl;
+        cout << "Standard Cases (Priority 1-4): " << counts.standardCount << endl;
+        displayBayStatus();
+    }
+    
+    // Free bays per capability and the called cases still waiting for one
+    void displayBayStatus() {
+        cout << "\nBays free (of total): ";
+        for (int cap = BayAllocator::CAPABILITY_COUNT - 1; cap >= 0; cap--) {
+            BayCapability c = (BayCapability)cap;
+            cout << BayAllocator::capabilityName(c) << " " << treatmentBays.getFreeCount(c)
+                 << "/" << treatmentBays.getBayCount(c) << (cap > 0 ? ", " : "\n");
+        }
         
-        for (int i = 0; i < processedCount; i++) {
-            cout << left << setw(10) << casesBeingProcessed[i].caseID
-                 << setw(25) << casesBeingProcessed[i].patientName
-                 << setw(20) << casesBeingProcessed[i].emergencyType
-                 << setw(10) << casesBeingProcessed[i].priorityLevel
-                 << setw(30) << casesBeingProcessed[i].arrivalTime << endl;
+        if (treatmentBays.getWaitingCount() == 0) return;
+        cout << "Waiting for a bay: " << treatmentBays.getWaitingCount() << endl;
+        treatmentBays.forEachWaiting([](const EmergencyCase& c) {
+            cout << "  Case #" << c.caseID << " " << c.patientName << " (Priority "
+                 << c.priorityLevel << ") needs "
+                 << BayAllocator::capabilityName(BayAllocator::requiredCapability(c)) << " bay\n";
+        });
+    }
+    
+    // Batch intake from a transfer file, one case per line:
+    //   Patient Name|Emergency Type|Priority (1-10)|Notes (optional)
+    // Blank lines and lines starting with '#' are ignored.
+    void batchIntakeFromFile() {
+        cout << "\n===== BATCH INTAKE FROM TRANSFER FILE =====\n";
+        
+        string fileName;
+        cout << "Enter transfer file path: ";
+        cin.ignore();
+        getline(cin, fileName);
+        
+        ifstream file(fileName.c_str());
+        if (!file) {
+            cout << "Cannot open file: " << fileName << endl;
+            return;
+        }
+        
+        vector<EmergencyCase> batch;
+        string line;
+        int lineNumber = 0;
+        int rejected = 0;
+        
+        while (getline(file, line)) {
+            lineNumber++;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            
+            string fields[4];
+            int fieldCount = 0;
+            stringstream ss(line);
+            while (fieldCount < 4 && getline(ss, fields[fieldCount], fieldCount < 3 ? '|' : '\n')) {
+                fields[fieldCount].erase(0, fields[fieldCount].find_first_not_of(" \t"));
+                fields[fieldCount].erase(fields[fieldCount].find_last_not_of(" \t") + 1);
+                fieldCount++;
+            }
             
-            if (!casesBeingProcessed[i].additionalNotes.empty()) {
-                cout << "  Notes: " << casesBeingProcessed[i].additionalNotes << endl;
+            long priority = 0;
+            if (fieldCount < 3 || fields[0].empty() || fields[1].empty() ||
+                !parseInteger(fields[2], priority) || priority < 1 || priority > 10) {
+                cout << "  Line " << lineNumber << " skipped (expected Name|Type|Priority 1-10|Notes)\n";
+                rejected++;
+                continue;
             }
+            
+            batch.push_back(EmergencyCase(nextCaseID++, fields[0], fields[1], (int)priority, fields[3]));
         }
         
-        cout << string(95, '=') << endl;
-        cout << "Total Cases Being Processed: " << processedCount << endl;
-        cout << "Critical Cases (Priority 8-10): " << criticalCount << endl;
-        cout << "Urgent Cases (Priority 5-7): " << urgentCount << endl;
-        cout << "Standard Cases (Priority 1-4): " << standardCount << endl;
+        priorityQueue->insertBatch(batch.begin(), batch.end());
+        int dispatchRequests = 0;
+        for (size_t i = 0; i < batch.size(); i++) {
+            indexName(batch[i]);
+            scheduleSla(batch[i]);
+            if (publishIfCritical(batch[i])) dispatchRequests++;
+        }
+        
+        cout << "\n" << batch.size() << " case(s) loaded from transfer file";
+        if (rejected > 0) {
+            cout << ", " << rejected << " line(s) rejected";
+        }
+        cout << ".\n";
+        if (!batch.empty()) {
+            cout << "Case IDs assigned: " << batch.front().caseID << " - " << batch.back().caseID << endl;
+        }
+        cout << "Pending cases in queue: " << priorityQueue->getSize() << endl;
+        if (priorityQueue->hasCriticalCases()) {
+            cout << "\n[ALERT] " << priorityQueue->getCriticalCount()
+                 << " CRITICAL case(s) pending - Immediate attention required!\n";
+        }
+        if (dispatchRequests > 0) {
+            cout << "[DISPATCH] " << dispatchRequests << " ambulance(s) requested automatically.\n";
+        }
+    }
+    
+    // Search pending and in-treatment cases by Case ID or patient name prefix
+    void searchCases() {
+        cout << "\n===== SEARCH EMERGENCY CASES =====\n";
+        
+        string query;
+        cout << "Enter Case ID or patient name (prefix): ";
+        cin.ignore();
+        getline(cin, query);
+        query.erase(0, query.find_first_not_of(" \t"));
+        query.erase(query.find_last_not_of(" \t") + 1);
+        
+        if (query.empty()) {
+            cout << "Search text cannot be empty.\n";
+            return;
+        }
+        
+        vector<int> matches;
+        if (query.find_first_not_of("0123456789") == string::npos) {
+            long number = 0;
+            if (!parseInteger(query, number) || number > INT_MAX) {
+                cout << "Case ID " << query << " is out of range.\n";
+                return;
+            }
+            int caseID = (int)number;
+            if (priorityQueue->findCase(caseID) != nullptr ||
+                treatmentBays.findWaiting(caseID) != nullptr ||
+                treatmentBoard.findByCaseID(caseID) != nullptr) {
+                matches.push_back(caseID);
+            }
+        } else {
+            string prefix = toLowerCase(query);
+            ensureNameIndex();
+            for (multimap<string, int>::iterator it = nameIndex.lower_bound(prefix);
+                 it != nameIndex.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+                matches.push_back(it->second);
+            }
+        }
+        
+        if (matches.empty()) {
+            cout << "No pending or in-treatment case matches \"" << query << "\".\n";
+            return;
+        }
+        
+        cout << "\n" << left << setw(10) << "Case ID"
+             << setw(25) << "Patient Name"
+             << setw(20) << "Emergency Type"
+             << setw(10) << "Priority"
+             << setw(15) << "State"
+             << setw(20) << "Queue Rank" << endl;
+        cout << string(100, '-') << endl;
+        for (size_t i = 0; i < matches.size(); i++) {
+            printSearchResult(matches[i]);
+        }
+        cout << string(100, '-') << endl;
+        cout << matches.size() << " case(s) found.\n";
+    }
+    
+    // Advance the SLA wheel to now and report cases that passed their
+    // time-to-treatment target while still pending
+    int checkSlaBreaches() {
+        vector<SlaTimingWheel::Breach> breaches;
+        slaWheel.advance(time(0), breaches);
+        slaBreachCount += (int)breaches.size();
+        
+        for (size_t i = 0; i < breaches.size(); i++) {
+            const EmergencyCase* c = priorityQueue->findCase(breaches[i].caseID);
+            if (c == nullptr) c = treatmentBays.findWaiting(breaches[i].caseID);
+            if (c == nullptr) continue;
+            
+            int waited = (int)difftime(time(0), c->arrivalTimeRaw) / 60;
+            cout << "[SLA BREACH] Case #" << c->caseID << " " << c->patientName
+                 << " (Priority " << c->priorityLevel << ") waiting " << waited
+                 << " min, target " << slaTargetMinutes(c->priorityLevel) << " min\n";
+        }
+        return (int)breaches.size();
+    }
+    
+    void viewSlaBreaches() {
+        cout << "\n===== SLA BREACH ALERTS =====\n";
+        if (checkSlaBreaches() == 0) {
+            cout << "No new SLA breaches.\n";
+        }
+        cout << "Targets: Critical " << slaTargetMinutes(8) << " min, Urgent "
+             << slaTargetMinutes(5) << " min, Standard " << slaTargetMinutes(1) << " min\n";
+        cout << "Pending cases on SLA watch: " << slaWheel.size() << endl;
+        cout << "Total breaches this session: " << slaBreachCount << endl;
+    }
+    
+    // Binary snapshot of pending heap and treatment board (EdSnapshot.hpp).
+    // writeSnapshot/restoreSnapshot do no console I/O; unplaced counts the
+    // treated cases that could not get their saved bay back.
+    bool writeSnapshot(const string& path, string& error);
+    bool restoreSnapshot(const string& path, string& error, int& unplaced);
+    void saveSnapshot();
+    void loadSnapshot();
+    
+    // Complete / discharge a case that is in treatment
+    void completeCase() {
+        cout << "\n===== COMPLETE / DISCHARGE CASE =====\n";
+        
+        if (treatmentBoard.isEmpty()) {
+            cout << "No cases are currently being processed.\n";
+            return;
+        }
+        
+        int caseID;
+        cout << "Enter Case ID to complete: ";
+        while (!(cin >> caseID)) {
+            cout << "Invalid input! Please enter a numeric Case ID: ";
+            cin.clear();
+            cin.ignore(10000, '\n');
+        }
+        
+        EmergencyCase discharged;
+        int reassignedCaseID;
+        if (finishCase(caseID, discharged, reassignedCaseID) != OP_OK) {
+            cout << "Case #" << caseID << " is not currently in treatment.\n";
+            return;
+        }
+        
+        cout << "\nCase #" << discharged.caseID << " (" << discharged.patientName
+             << ") has been completed and discharged from treatment.\n";
+        
+        // The freed bay went straight to the best waiting case it can serve
+        const EmergencyCase* next = (reassignedCaseID != -1) ? treatmentBoard.findByCaseID(reassignedCaseID) : nullptr;
+        if (next != nullptr) {
+            cout << "Bay " << treatmentBays.bayLabel(treatmentBays.bayOf(reassignedCaseID)) << " reassigned to Case #"
+                 << next->caseID << " (" << next->patientName << ", Priority "
+                 << next->priorityLevel << ").\n";
+        }
+        cout << "Cases currently being processed: " << treatmentBoard.size() << endl;
     }
     
     // View Pending Emergency Cases
@@ -491,8 +1421,20 @@ public:
     
     // Check if there are critical cases 
     bool hasCriticalCases() {
-        if (priorityQueue->isEmpty()) return false;
-        return priorityQueue->peekMostCritical().priorityLevel >= 8;
+        return priorityQueue->hasCriticalCases();
+    }
+    
+    // O(1) reads for dashboards polling the department state
+    const PriorityHistogram& getProcessingHistogram() {
+        return treatmentBoard.getHistogram();
+    }
+    
+    int getCasesBeingProcessed() {
+        return treatmentBoard.size();
+    }
+    
+    EmergencyPriorityQueue& getPendingQueue() {
+        return *priorityQueue;
     }
     
     // Display officer information
@@ -501,8 +1443,13 @@ public:
         cout << "Officer Name: " << officerName << endl;
         cout << "Department Code: " << departmentCode << endl;
         cout << "Active Cases: " << priorityQueue->getSize() << endl;
-        cout << "Cases Being Processed: " << processedCount << endl;
-        cout << "Total Cases in System: " << (priorityQueue->getSize() + processedCount) << endl;
+        cout << "Cases Being Processed: " << treatmentBoard.size() << endl;
+        cout << "Cases Awaiting a Bay: " << treatmentBays.getWaitingCount() << endl;
+        cout << "Bays Occupied: " << treatmentBays.getOccupiedCount() << "/"
+             << treatmentBays.getTotalBays() << endl;
+        cout << "Total Cases in System: " << (priorityQueue->getSize() + treatmentBays.getWaitingCount()
+                                              + treatmentBoard.size()) << endl;
+        cout << "SLA Breaches: " << slaBreachCount << endl;
         cout << "============================================\n";
     }
     void menu();
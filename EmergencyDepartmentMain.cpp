@@ -1,16 +1,18 @@
 #include "EmergencyDepartment.hpp"
+#include "EdSnapshot.hpp"
 #include <iostream>
 #include <cstdlib>
 #include <limits>
 
 using namespace std;
 
-// Function to clear screen (cross-platform)
+// Function to clear screen (cross-platform); ANSI home + erase, the same
+// bytes `clear` prints, rather than forking a shell on every redraw
 void clearScreen() {
     #ifdef _WIN32
         system("cls");
     #else
-        system("clear");
+        cout << "\033[H\033[2J\033[3J" << flush;
     #endif
 }
 
@@ -35,6 +37,12 @@ void displayMainMenu() {
     cout << " 6. View Officer Information                     \n";
     cout << " 7. Generate Sample Test Cases                   \n";
     cout << " 8. Clear All Cases (Reset System)               \n";
+    cout << " 9. Complete / Discharge Case in Treatment       \n";
+    cout << "10. Batch Intake from Transfer File              \n";
+    cout << "11. Search Case by ID / Patient Name             \n";
+    cout << "12. Check SLA Breach Alerts                      \n";
+    cout << "13. Save Snapshot to File                        \n";
+    cout << "14. Restore Snapshot from File                   \n";
     cout << " 0. Exit System                                  \n";
     cout << "==================================================\n";
     cout << "Enter your choice: ";
@@ -74,16 +82,17 @@ void generateSampleCases(EmergencyDepartmentOfficer& officer) {
     
     cout << "Generating " << numSamples << " sample emergency cases...\n\n";
     
-    // Insert sample cases
+    // Insert sample cases as one batch (bottom-up heap construction)
+    vector<EmergencyCase> batch;
     for (int i = 0; i < numSamples; i++) {
-        EmergencyCase newCase(2001 + i, samples[i].name, samples[i].type, 
-                             samples[i].priority, samples[i].notes);
-        testQueue.insertEmergencyCase(newCase);
+        batch.push_back(EmergencyCase(2001 + i, samples[i].name, samples[i].type, 
+                                      samples[i].priority, samples[i].notes));
         
         cout << "Added: " << samples[i].name 
              << " - " << samples[i].type 
              << " (Priority: " << samples[i].priority << ")\n";
     }
+    testQueue.insertBatch(batch.begin(), batch.end());
     
     cout << "\n " << numSamples << " sample cases generated successfully!\n";
     
@@ -105,6 +114,120 @@ void generateSampleCases(EmergencyDepartmentOfficer& officer) {
     testQueue.displayAllCases();
 }
 
+// Write pending heap, waitlists and treatment board to a binary snapshot
+bool EmergencyDepartmentOfficer::writeSnapshot(const string& path, string& error) {
+    EdSnapshotState state;
+    state.nextCaseID = nextCaseID;
+    state.slaBreachCount = slaBreachCount;
+    
+    // Bays are saved as held, so a restore puts every case back where it was
+    treatmentBoard.forEachInStartOrder([this, &state](const EmergencyCase& c, const string&) {
+        state.treatmentBayIDs.push_back(treatmentBays.bayOf(c.caseID));
+    });
+    treatmentBays.forEachWaiting([&state](const EmergencyCase& c) {
+        state.awaitingBay.push_back(c);
+    });
+    return EdSnapshot::write(path, *priorityQueue, treatmentBoard, state, error);
+}
+
+// Replace all cases with the contents of a snapshot; current cases are kept
+// when the file does not check out
+bool EmergencyDepartmentOfficer::restoreSnapshot(const string& path, string& error, int& unplaced) {
+    EdSnapshotState state;
+    if (!EdSnapshot::read(path, *priorityQueue, treatmentBoard, state, treatmentBays, error)) {
+        return false;
+    }
+    
+    nextCaseID = state.nextCaseID;
+    slaBreachCount = state.slaBreachCount;
+    
+    // Put treated cases back in their saved bays (read() checked them)
+    treatmentBays.clear();
+    size_t treated = 0;
+    unplaced = 0;
+    treatmentBoard.forEachInStartOrder([&](const EmergencyCase& c, const string&) {
+        if (!treatmentBays.occupyBay(state.treatmentBayIDs[treated++], c)) {
+            unplaced++;
+        }
+    });
+    
+    // Derived indexes: SLA deadlines now (pending and still waiting for a
+    // bay, as on the live path), the name index on first search
+    slaWheel.clear();
+    slaWheel.reserve((size_t)priorityQueue->getSize() + state.awaitingBay.size());
+    for (int i = 0; i < priorityQueue->getSize(); i++) {
+        scheduleSla(priorityQueue->caseAt(i));
+    }
+    for (size_t i = 0; i < state.awaitingBay.size(); i++) {
+        treatmentBays.addWaiting(state.awaitingBay[i]);
+        scheduleSla(state.awaitingBay[i]);
+    }
+    nameIndex.clear();
+    nameIndexStale = true;
+    return true;
+}
+
+void EmergencyDepartmentOfficer::saveSnapshot() {
+    cout << "\n===== SAVE SNAPSHOT =====\n";
+    
+    string path;
+    cout << "Enter snapshot file path: ";
+    cin.ignore();
+    getline(cin, path);
+    if (path.empty()) {
+        cout << "File path cannot be empty.\n";
+        return;
+    }
+    
+    string error;
+    if (!writeSnapshot(path, error)) {
+        cout << "Snapshot failed: " << error << endl;
+        return;
+    }
+    cout << "Snapshot saved to " << path << " (" << priorityQueue->getSize() << " pending, "
+         << treatmentBays.getWaitingCount() << " waiting for a bay, "
+         << treatmentBoard.size() << " in treatment).\n";
+}
+
+void EmergencyDepartmentOfficer::loadSnapshot() {
+    cout << "\n===== RESTORE SNAPSHOT =====\n";
+    
+    string path;
+    cout << "Enter snapshot file path: ";
+    cin.ignore();
+    getline(cin, path);
+    if (path.empty()) {
+        cout << "File path cannot be empty.\n";
+        return;
+    }
+    
+    cout << "WARNING: This replaces all current cases. Continue? (Y/N): ";
+    char confirm;
+    cin >> confirm;
+    if (confirm != 'Y' && confirm != 'y') {
+        cout << "Operation cancelled.\n";
+        return;
+    }
+    
+    string error;
+    int unplaced = 0;
+    if (!restoreSnapshot(path, error, unplaced)) {
+        cout << "Restore failed: " << error << ". Current cases were kept.\n";
+        return;
+    }
+    if (unplaced > 0) {
+        cout << "[WARNING] " << unplaced << " case(s) in treatment could not get their saved bay.\n";
+    }
+    
+    cout << "Snapshot restored: " << priorityQueue->getSize() << " pending, "
+         << treatmentBays.getWaitingCount() << " waiting for a bay, "
+         << treatmentBoard.size() << " in treatment.\n";
+    if (priorityQueue->hasCriticalCases()) {
+        cout << "\n[ALERT] " << priorityQueue->getCriticalCount()
+             << " CRITICAL case(s) pending - Immediate attention required!\n";
+    }
+}
+
 // Main program
 void EmergencyDepartmentOfficer::menu() {
     int choice;
@@ -125,6 +248,7 @@ void EmergencyDepartmentOfficer::menu() {
     // Main program loop
     while (!exitProgram) {
         clearScreen();
+        showDispatchNotices();
         displayMainMenu();
         
         // Input validation for menu choice
@@ -200,9 +324,11 @@ void EmergencyDepartmentOfficer::menu() {
                     priorityQueue = new EmergencyPriorityQueue(20);
                     
                     // Reset processed cases
-                    delete[] casesBeingProcessed;
-                    casesBeingProcessed = new EmergencyCase[maxProcessedCapacity];
-                    processedCount = 0;
+                    treatmentBoard.clear();
+                    nameIndex.clear();
+                    slaWheel.clear();
+                    treatmentBays.clear();
+                    slaBreachCount = 0;
                     
                     // Reset case ID counter
                     nextCaseID = 1001;
@@ -214,6 +340,48 @@ void EmergencyDepartmentOfficer::menu() {
                 pauseScreen();
                 break;
                 
+            case 9:
+                // Complete / Discharge Case
+                clearScreen();
+                completeCase();
+                pauseScreen();
+                break;
+                
+            case 10:
+                // Batch Intake from Transfer File
+                clearScreen();
+                batchIntakeFromFile();
+                pauseScreen();
+                break;
+                
+            case 11:
+                // Search Case by ID / Patient Name
+                clearScreen();
+                searchCases();
+                pauseScreen();
+                break;
+                
+            case 12:
+                // Check SLA Breach Alerts
+                clearScreen();
+                viewSlaBreaches();
+                pauseScreen();
+                break;
+                
+            case 13:
+                // Save Snapshot
+                clearScreen();
+                saveSnapshot();
+                pauseScreen();
+                break;
+                
+            case 14:
+                // Restore Snapshot
+                clearScreen();
+                loadSnapshot();
+                pauseScreen();
+                break;
+                
             case 0:
                 // Return to main menu
                 clearScreen();
@@ -0,0 +1,136 @@
+#ifndef EVENT_BUS_HPP
+#define EVENT_BUS_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum HospitalEventType {
+    EVENT_CRITICAL_CASE_LOGGED = 0, // ED case at or above the dispatch threshold
+    EVENT_AMBULANCE_ASSIGNED,       // a unit was reserved for a case
+    EVENT_DISPATCH_FAILED,          // no unit was Available for a case
+    EVENT_TYPE_COUNT
+};
+
+struct HospitalEvent {
+    HospitalEventType type;
+    int caseID;
+    int priority;
+    string patientName;
+    string emergencyType;
+    string ambulanceID;     // set on EVENT_AMBULANCE_ASSIGNED
+    long long loggedNs;     // steady_clock time the case was logged
+
+    HospitalEvent() : type(EVENT_CRITICAL_CASE_LOGGED), caseID(0), priority(0), loggedNs(0) {}
+};
+
+// In-process publish/subscribe between the hospital modules.
+//
+// Each subscriber owns a mailbox (a locked FIFO with a condition variable)
+// and names the event types it wants. publish() copies the event into every
+// matching mailbox and returns at once; the subscriber consumes on its own
+// thread with waitNext (blocking) or pollNext.
+class EventBus {
+private:
+    struct Mailbox {
+        mutex lock;
+        condition_variable ready;
+        deque<HospitalEvent> events;
+        unsigned typeMask;
+        bool closed;
+
+        explicit Mailbox(unsigned mask) : typeMask(mask), closed(false) {}
+    };
+
+    mutex subscribersLock;
+    vector<Mailbox*> mailboxes;
+
+    // subscribe() may grow the vector, so look the mailbox up under the lock
+    Mailbox& boxOf(int mailbox) {
+        lock_guard<mutex> guard(subscribersLock);
+        return *mailboxes[mailbox];
+    }
+
+public:
+    EventBus() {}
+
+    ~EventBus() {
+        for (size_t i = 0; i < mailboxes.size(); i++) {
+            delete mailboxes[i];
+        }
+    }
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    static unsigned maskOf(HospitalEventType type) {
+        return 1u << type;
+    }
+
+    static long long nowNs() {
+        return chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Returns the mailbox id for waitNext / pollNext / close
+    int subscribe(unsigned typeMask) {
+        lock_guard<mutex> guard(subscribersLock);
+        mailboxes.push_back(new Mailbox(typeMask));
+        return (int)mailboxes.size() - 1;
+    }
+
+    // Returns how many mailboxes received the event
+    int publish(const HospitalEvent& event) {
+        int delivered = 0;
+        lock_guard<mutex> guard(subscribersLock);
+        for (size_t i = 0; i < mailboxes.size(); i++) {
+            Mailbox& box = *mailboxes[i];
+            if ((box.typeMask & maskOf(event.type)) == 0) continue;
+            {
+                lock_guard<mutex> boxGuard(box.lock);
+                if (box.closed) continue;
+                box.events.push_back(event);
+            }
+            box.ready.notify_one();
+            delivered++;
+        }
+        return delivered;
+    }
+
+    // Block until an event arrives; false once the mailbox is closed and drained
+    bool waitNext(int mailbox, HospitalEvent& out) {
+        Mailbox& box = boxOf(mailbox);
+        unique_lock<mutex> guard(box.lock);
+        box.ready.wait(guard, [&box]() { return !box.events.empty() || box.closed; });
+        if (box.events.empty()) return false;
+        out = std::move(box.events.front());
+        box.events.pop_front();
+        return true;
+    }
+
+    bool pollNext(int mailbox, HospitalEvent& out) {
+        Mailbox& box = boxOf(mailbox);
+        lock_guard<mutex> guard(box.lock);
+        if (box.events.empty()) return false;
+        out = std::move(box.events.front());
+        box.events.pop_front();
+        return true;
+    }
+
+    // Stop delivery to a mailbox and wake its waiting subscriber
+    void close(int mailbox) {
+        Mailbox& box = boxOf(mailbox);
+        {
+            lock_guard<mutex> guard(box.lock);
+            box.closed = true;
+        }
+        box.ready.notify_all();
+    }
+};
+
+#endif // EVENT_BUS_HPP
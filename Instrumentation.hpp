@@ -0,0 +1,358 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Hot-path instrumentation, built in with -DHOSPITAL_INSTRUMENTATION.
+//
+// HOSPITAL_TIMED(op) at the top of a core operation counts the call and, for
+// one call in HOSPITAL_INSTRUMENTATION_SAMPLE_EVERY, records its duration in
+// a latency histogram. Counts are exact; latencies come from the sample,
+// because two clock reads cost about half a heap insert. Every
+// thread writes only its own counters (no locks, no shared cache lines);
+// readers sum the per-thread blocks. Without the flag the macro is empty.
+#ifndef HOSPITAL_INSTRUMENTATION_SAMPLE_EVERY
+#define HOSPITAL_INSTRUMENTATION_SAMPLE_EVERY 64
+#endif
+
+#ifdef HOSPITAL_INSTRUMENTATION
+#define HOSPITAL_TIMED(op) OperationTimer hospitalOperationTimer(op)
+#else
+#define HOSPITAL_TIMED(op) ((void)0)
+#endif
+
+inline bool instrumentationEnabled() {
+#ifdef HOSPITAL_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+enum InstrumentedOperation {
+    METRIC_ADMIT = 0,       // PatientQueue::admit
+    METRIC_DISCHARGE,       // PatientQueue::discharge
+    METRIC_INSERT_CASE,     // EmergencyPriorityQueue::insertEmergencyCase
+    METRIC_EXTRACT_CASE,    // EmergencyPriorityQueue::extractMostCritical
+    METRIC_ADD_STOCK,       // MedicalSupply::addStock
+    METRIC_PURGE_EXPIRED,   // MedicalSupply::purgeExpired
+    METRIC_SET_STATUS,      // AmbulanceQueue::setStatus (menu "Update Status" too)
+    METRIC_OPERATION_COUNT
+};
+
+inline const char* metricName(int op) {
+    static const char* names[METRIC_OPERATION_COUNT] = {
+        "admit", "discharge", "insertEmergencyCase", "extractMostCritical",
+        "addStock", "purgeExpired", "setStatus"
+    };
+    return (op >= 0 && op < METRIC_OPERATION_COUNT) ? names[op] : "unknown";
+}
+
+// HDR-style log-linear buckets: values below 8 ns get their own bucket,
+// above that each power of two is split into 8 linear sub-buckets, so a
+// recorded value is within 12.5% of its bucket bounds. 320 buckets reach
+// past 15 minutes.
+struct LatencyBuckets {
+    static const int COUNT = 320;
+
+    static int indexOf(unsigned long long ns) {
+        if (ns < 8) return (int)ns;
+        int exponent = 63 - __builtin_clzll(ns);
+        int index = (exponent - 2) * 8 + (int)((ns >> (exponent - 3)) & 7);
+        return index < COUNT ? index : COUNT - 1;
+    }
+
+    static unsigned long long lowerBound(int index) {
+        if (index < 8) return (unsigned long long)index;
+        return (unsigned long long)(8 + index % 8) << (index / 8 - 1);
+    }
+
+    static unsigned long long upperBound(int index) {
+        if (index < 8) return (unsigned long long)index;
+        return lowerBound(index) + (1ULL << (index / 8 - 1)) - 1;
+    }
+};
+
+// One thread's counters for one operation. Only the owning thread writes
+// (plain load + store), other threads read with relaxed loads.
+struct OperationCounters {
+    atomic<unsigned long long> calls;
+    atomic<unsigned long long> sampled;
+    atomic<unsigned long long> totalNs;   // sum over the sampled calls
+    atomic<unsigned long long> maxNs;
+    atomic<unsigned long long> buckets[LatencyBuckets::COUNT];
+
+    OperationCounters() : calls(0), sampled(0), totalNs(0), maxNs(0) {
+        for (int i = 0; i < LatencyBuckets::COUNT; i++) buckets[i].store(0, memory_order_relaxed);
+    }
+
+    static void bump(atomic<unsigned long long>& counter, unsigned long long by) {
+        counter.store(counter.load(memory_order_relaxed) + by, memory_order_relaxed);
+    }
+
+    void record(unsigned long long ns) {
+        bump(sampled, 1);
+        bump(totalNs, ns);
+        bump(buckets[LatencyBuckets::indexOf(ns)], 1);
+        if (ns > maxNs.load(memory_order_relaxed)) maxNs.store(ns, memory_order_relaxed);
+    }
+};
+
+struct ThreadMetrics {
+    OperationCounters operations[METRIC_OPERATION_COUNT];
+};
+
+// Totals for one operation across all threads
+struct OperationSnapshot {
+    unsigned long long calls;
+    unsigned long long sampled;
+    unsigned long long totalNs;
+    unsigned long long maxNs;
+    vector<unsigned long long> buckets;
+
+    OperationSnapshot() : calls(0), sampled(0), totalNs(0), maxNs(0), buckets(LatencyBuckets::COUNT, 0) {}
+
+    // Latency at quantile q (0..1) of the sampled calls: midpoint of the
+    // bucket holding that rank, never above the largest value seen
+    double quantileNs(double q) const {
+        if (sampled == 0) return 0;
+        unsigned long long rank = (unsigned long long)(q * sampled);
+        if (rank < 1) rank = 1;
+        unsigned long long seen = 0;
+        for (int i = 0; i < LatencyBuckets::COUNT; i++) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                double mid = (LatencyBuckets::lowerBound(i) + LatencyBuckets::upperBound(i)) / 2.0;
+                return mid < maxNs ? mid : (double)maxNs;
+            }
+        }
+        return (double)maxNs;
+    }
+
+    double meanNs() const { return sampled == 0 ? 0 : (double)totalNs / sampled; }
+};
+
+// Owns every thread's ThreadMetrics. A block outlives its thread so totals
+// keep the work of threads that have finished (one small block per thread
+// ever started).
+class InstrumentationRegistry {
+private:
+    mutex lock;
+    vector<unique_ptr<ThreadMetrics> > threads;
+
+public:
+    static InstrumentationRegistry& instance() {
+        static InstrumentationRegistry registry;
+        return registry;
+    }
+
+    ThreadMetrics& local() {
+        static thread_local ThreadMetrics* mine = nullptr;
+        if (mine == nullptr) {
+            lock_guard<mutex> guard(lock);
+            threads.emplace_back(new ThreadMetrics());
+            mine = threads.back().get();
+        }
+        return *mine;
+    }
+
+    OperationSnapshot snapshot(int op) {
+        OperationSnapshot total;
+        lock_guard<mutex> guard(lock);
+        for (size_t t = 0; t < threads.size(); t++) {
+            const OperationCounters& c = threads[t]->operations[op];
+            total.calls += c.calls.load(memory_order_relaxed);
+            total.sampled += c.sampled.load(memory_order_relaxed);
+            total.totalNs += c.totalNs.load(memory_order_relaxed);
+            unsigned long long maxNs = c.maxNs.load(memory_order_relaxed);
+            if (maxNs > total.maxNs) total.maxNs = maxNs;
+            for (int i = 0; i < LatencyBuckets::COUNT; i++) {
+                total.buckets[i] += c.buckets[i].load(memory_order_relaxed);
+            }
+        }
+        return total;
+    }
+};
+
+// Scope guard behind HOSPITAL_TIMED
+class OperationTimer {
+private:
+    OperationCounters* counters; // null when this call is not sampled
+    chrono::steady_clock::time_point started;
+
+public:
+    explicit OperationTimer(InstrumentedOperation op) : counters(nullptr) {
+        OperationCounters& c = InstrumentationRegistry::instance().local().operations[op];
+        unsigned long long calls = c.calls.load(memory_order_relaxed);
+        c.calls.store(calls + 1, memory_order_relaxed);
+        if (calls % HOSPITAL_INSTRUMENTATION_SAMPLE_EVERY == 0) {
+            counters = &c;
+            started = chrono::steady_clock::now();
+        }
+    }
+
+    ~OperationTimer() {
+        if (counters != nullptr) {
+            counters->record((unsigned long long)chrono::duration_cast<chrono::nanoseconds>(
+                chrono::steady_clock::now() - started).count());
+        }
+    }
+
+    OperationTimer(const OperationTimer&) = delete;
+    OperationTimer& operator=(const OperationTimer&) = delete;
+};
+
+// Human-readable table for the "Operation Stats" menu
+inline void printOperationStats(ostream& out) {
+    if (!instrumentationEnabled()) {
+        out << "Instrumentation is off (rebuild with -DHOSPITAL_INSTRUMENTATION).\n";
+        return;
+    }
+    out << "Latency sampled on 1 in " << HOSPITAL_INSTRUMENTATION_SAMPLE_EVERY << " calls\n\n";
+    out << left << setw(22) << "Operation" << right << setw(12) << "Calls" << setw(10) << "Mean us"
+        << setw(10) << "p50 us" << setw(10) << "p99 us" << setw(11) << "p99.9 us" << setw(10) << "Max us" << "\n";
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << fixed << setprecision(2);
+    for (int op = 0; op < METRIC_OPERATION_COUNT; op++) {
+        OperationSnapshot s = InstrumentationRegistry::instance().snapshot(op);
+        out << left << setw(22) << metricName(op) << right << setw(12) << s.calls << setw(10)
+            << s.meanNs() / 1000 << setw(10) << s.quantileNs(0.5) / 1000 << setw(10) << s.quantileNs(0.99) / 1000
+            << setw(11) << s.quantileNs(0.999) / 1000 << setw(10) << s.maxNs / 1000.0 << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// Prometheus text exposition format (version 0.0.4)
+inline void writePrometheus(ostream& out) {
+    static const double bucketBounds[] = {
+        250e-9, 500e-9, 1e-6, 2.5e-6, 5e-6, 10e-6, 25e-6, 50e-6, 100e-6,
+        250e-6, 500e-6, 1e-3, 2.5e-3, 5e-3, 10e-3, 25e-3, 50e-3, 100e-3
+    };
+    static const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    const int boundCount = sizeof(bucketBounds) / sizeof(bucketBounds[0]);
+
+    vector<OperationSnapshot> snapshots;
+    for (int op = 0; op < METRIC_OPERATION_COUNT; op++) {
+        snapshots.push_back(InstrumentationRegistry::instance().snapshot(op));
+    }
+
+    out << "# HELP hospital_instrumentation_enabled 1 when built with HOSPITAL_INSTRUMENTATION.\n"
+        << "# TYPE hospital_instrumentation_enabled gauge\n"
+        << "hospital_instrumentation_enabled " << (instrumentationEnabled() ? 1 : 0) << "\n"
+        << "# HELP hospital_instrumentation_sample_every Calls per latency sample.\n"
+        << "# TYPE hospital_instrumentation_sample_every gauge\n"
+        << "hospital_instrumentation_sample_every " << HOSPITAL_INSTRUMENTATION_SAMPLE_EVERY << "\n";
+
+    out << "# HELP hospital_operations_total Calls of each core operation.\n"
+        << "# TYPE hospital_operations_total counter\n";
+    for (int op = 0; op < METRIC_OPERATION_COUNT; op++) {
+        out << "hospital_operations_total{operation=\"" << metricName(op) << "\"} " << snapshots[op].calls << "\n";
+    }
+
+    out << "# HELP hospital_operation_duration_seconds Latency of the sampled calls.\n"
+        << "# TYPE hospital_operation_duration_seconds histogram\n";
+    for (int op = 0; op < METRIC_OPERATION_COUNT; op++) {
+        const OperationSnapshot& s = snapshots[op];
+        string label = string("operation=\"") + metricName(op) + "\"";
+        // A fine bucket counts towards the first bound that covers all of it
+        int fine = 0;
+        unsigned long long cumulative = 0;
+        for (int b = 0; b < boundCount; b++) {
+            while (fine < LatencyBuckets::COUNT && LatencyBuckets::upperBound(fine) <= bucketBounds[b] * 1e9) {
+                cumulative += s.buckets[fine++];
+            }
+            out << "hospital_operation_duration_seconds_bucket{" << label << ",le=\"" << bucketBounds[b] << "\"} "
+                << cumulative << "\n";
+        }
+        out << "hospital_operation_duration_seconds_bucket{" << label << ",le=\"+Inf\"} " << s.sampled << "\n"
+            << "hospital_operation_duration_seconds_sum{" << label << "} " << s.totalNs / 1e9 << "\n"
+            << "hospital_operation_duration_seconds_count{" << label << "} " << s.sampled << "\n";
+    }
+
+    out << "# HELP hospital_operation_latency_seconds Latency quantiles of the sampled calls.\n"
+        << "# TYPE hospital_operation_latency_seconds gauge\n";
+    for (int op = 0; op < METRIC_OPERATION_COUNT; op++) {
+        for (size_t q = 0; q < sizeof(quantiles) / sizeof(quantiles[0]); q++) {
+            out << "hospital_operation_latency_seconds{operation=\"" << metricName(op) << "\",quantile=\""
+                << quantiles[q] << "\"} " << snapshots[op].quantileNs(quantiles[q]) / 1e9 << "\n";
+        }
+    }
+}
+
+// Rewrites a Prometheus text file (e.g. for node_exporter's textfile
+// collector) every intervalSeconds, and once more on stop. Each rewrite goes
+// to <path>.tmp first and is renamed over <path>, so a reader never sees a
+// half-written file.
+class MetricsFileWriter {
+private:
+    string path;
+    int intervalSeconds;
+    mutex lock;
+    condition_variable wake;
+    bool stopping;
+    thread worker;
+
+    void run() {
+        unique_lock<mutex> guard(lock);
+        while (!stopping) {
+            guard.unlock();
+            writeNow();
+            guard.lock();
+            wake.wait_for(guard, chrono::seconds(intervalSeconds), [this]() { return stopping; });
+        }
+    }
+
+public:
+    MetricsFileWriter(const string& path, int intervalSeconds)
+        : path(path), intervalSeconds(intervalSeconds > 0 ? intervalSeconds : 1), stopping(false) {
+        worker = thread(&MetricsFileWriter::run, this);
+    }
+
+    ~MetricsFileWriter() {
+        stop();
+    }
+
+    MetricsFileWriter(const MetricsFileWriter&) = delete;
+    MetricsFileWriter& operator=(const MetricsFileWriter&) = delete;
+
+    bool writeNow() {
+        string temporary = path + ".tmp";
+        {
+            ofstream out(temporary.c_str());
+            if (!out) return false;
+            writePrometheus(out);
+            if (!out) return false;
+        }
+#ifdef _WIN32
+        remove(path.c_str()); // rename does not replace on Windows
+#endif
+        return rename(temporary.c_str(), path.c_str()) == 0;
+    }
+
+    void stop() {
+        {
+            lock_guard<mutex> guard(lock);
+            if (stopping) return;
+            stopping = true;
+        }
+        wake.notify_all();
+        if (worker.joinable()) worker.join();
+        writeNow();
+    }
+};
+
+#endif
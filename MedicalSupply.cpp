@@ -12,10 +12,12 @@
 //   Push (Add Supply)        → O(1)
 //   Pop (Use Last Supply)    → O(1)
 //   View (Traverse Stack)    → O(n)
+//   Dispense by Type         → O(n)
 //   RemoveExpiredSupplies    → O(n)
 // ============================================================================
 
 #include "MedicalSupply.hpp"
+#include "Instrumentation.hpp"
 #include <iostream>
 #include <string>
 #include <limits>
@@ -82,7 +84,8 @@ bool isValidNumericDate(int y, int m, int d) {
 }
 
 bool isValidDateStrict(const string& date) {
-    if (!regex_match(date, regex(R"(\d{4}-\d{2}-\d{2})"))) return false;
+    static const regex datePattern(R"(\d{4}-\d{2}-\d{2})"); // compiled once
+    if (!regex_match(date, datePattern)) return false;
 
     int y, m, d;
     sscanf(date.c_str(), "%d-%d-%d", &y, &m, &d);
@@ -124,6 +127,119 @@ int MedicalSupply::getItemCount() const {
     return itemCount;
 }
 
+// ==========================================================
+// CORE API: ADD STOCK (PUSH)
+// ==========================================================
+OpStatus MedicalSupply::addStock(const string& type, int qty, const string& expiry,
+                                 const string& remark, string* batchID) {
+    HOSPITAL_TIMED(METRIC_ADD_STOCK);
+    if (type.empty() || qty <= 0 || !isValidDateStrict(expiry) || !isDateInFutureStrict(expiry)) {
+        return OP_INVALID_ARGUMENT;
+    }
+
+    SupplyItem* n = new SupplyItem(type, qty, generateBatchID(), expiry, remark);
+    n->next = top;
+    top = n;
+    itemCount++;
+
+    if (batchID != nullptr) *batchID = n->batch;
+    return OP_OK;
+}
+
+// Unlink `item` (whose predecessor is `prev`, nullptr at the top) and free it
+static void unlinkSupply(SupplyItem*& top, SupplyItem* prev, SupplyItem* item) {
+    if (prev == nullptr) {
+        top = item->next;
+    } else {
+        prev->next = item->next;
+    }
+    delete item;
+}
+
+// ==========================================================
+// CORE API: USE LAST ADDED (POP WHEN USED UP)
+// ==========================================================
+OpStatus MedicalSupply::useLast(int qty, int* left) {
+    if (isEmpty()) return OP_EMPTY;
+    if (qty <= 0) return OP_INVALID_ARGUMENT;
+    if (qty > top->quantity) return OP_INSUFFICIENT;
+
+    top->quantity -= qty;
+    if (left != nullptr) *left = top->quantity;
+
+    // A used-up batch leaves storage
+    if (top->quantity == 0) {
+        unlinkSupply(top, nullptr, top);
+        itemCount--;
+    }
+    return OP_OK;
+}
+
+// ==========================================================
+// CORE API: DISPENSE BY TYPE (NEWEST BATCHES FIRST)
+// ==========================================================
+int MedicalSupply::quantityOf(const string& type) const {
+    int total = 0;
+    for (const SupplyItem* cur = top; cur != nullptr; cur = cur->next) {
+        if (cur->type == type) total += cur->quantity;
+    }
+    return total;
+}
+
+OpStatus MedicalSupply::dispense(const string& type, int qty) {
+    if (type.empty() || qty <= 0) return OP_INVALID_ARGUMENT;
+    int inStock = quantityOf(type);
+    if (inStock == 0) return OP_NOT_FOUND;
+    if (inStock < qty) return OP_INSUFFICIENT;
+
+    SupplyItem* prev = nullptr;
+    SupplyItem* curr = top;
+    while (qty > 0) {
+        if (curr->type != type) {
+            prev = curr;
+            curr = curr->next;
+            continue;
+        }
+        int take = qty < curr->quantity ? qty : curr->quantity;
+        curr->quantity -= take;
+        qty -= take;
+        if (curr->quantity == 0) {
+            SupplyItem* next = curr->next;
+            unlinkSupply(top, prev, curr);
+            itemCount--;
+            curr = next;
+        }
+    }
+    return OP_OK;
+}
+
+// ==========================================================
+// CORE API: PURGE EXPIRED (LINKED LIST TRAVERSAL)
+// ==========================================================
+int MedicalSupply::purgeExpired(vector<SupplyItem>* removed) {
+    HOSPITAL_TIMED(METRIC_PURGE_EXPIRED);
+    SupplyItem* curr = top;
+    SupplyItem* prev = nullptr;
+    int removedCount = 0;
+
+    while (curr != nullptr) {
+        SupplyItem* next = curr->next;
+        if (isDateExpired(curr->expiryDate)) {
+            if (removed != nullptr) {
+                removed->push_back(*curr);
+                removed->back().next = nullptr;
+            }
+            unlinkSupply(top, prev, curr);
+            itemCount--;
+            removedCount++;
+        } else {
+            prev = curr;
+        }
+        curr = next;
+    }
+    return removedCount;
+}
+
 // ==========================================================
 // MENU
 // ==========================================================
@@ -138,6 +254,7 @@ void MedicalSupply::menu() {
         cout << " 2. Use Last Added Supply\n";
         cout << " 3. View Current Supplies\n";
         cout << " 4. Remove Expired Supplies\n";
+        cout << " 5. Dispense Supply by Type\n";
         cout << " 0. Back to Main Menu\n";
         cout << "==================================================\n";
         cout << " Enter your choice: ";
@@ -148,6 +265,7 @@ void MedicalSupply::menu() {
             case 2: useLastAddedSupply(); break;
             case 3: viewCurrentSupplies(); break;
             case 4: removeExpiredSupplies(); break;
+            case 5: dispenseSupply(); break;
             case 0:
                 cout << " Returning to Main Menu...\n";
                 break;
@@ -169,6 +287,10 @@ void MedicalSupply::addSupplyStock() {
     cout << "\n============ ADD SUPPLY STOCK ============\n";
     cout << " Enter supply type: ";
     getline(cin, type);
+    while (type.empty()) {
+        cout << " Supply type cannot be empty. Enter supply type: ";
+        getline(cin, type);
+    }
 
     cout << " Enter quantity: ";
     while (!(cin >> qty) || qty <= 0) {
@@ -189,12 +311,8 @@ void MedicalSupply::addSupplyStock() {
     cout << " Enter remarks (optional): ";
     getline(cin, remark);
 
-    string batchID = generateBatchID();
-    SupplyItem* n = new SupplyItem(type, qty, batchID, expiry, remark);
-
-    n->next = top;
-    top = n;
-    itemCount++;
+    string batchID;
+    addStock(type, qty, expiry, remark, &batchID);
 
     cout << "\n========== SUPPLY ADD TICKET ==========\n";
     cout << " Type        : " << type << "\n";
@@ -214,13 +332,13 @@ void MedicalSupply::useLastAddedSupply() {
         return;
     }
 
-    SupplyItem* item = top;
+    SupplyItem item = *top;
 
     cout << "\n============ USE LAST ADDED SUPPLY ============\n";
-    cout << " Type        : " << item->type << "\n";
-    cout << " Qty in Stock: " << item->quantity << "\n";
-    cout << " Batch ID    : " << item->batch << "\n";
-    cout << " Expiry Date : " << item->expiryDate << "\n";
+    cout << " Type        : " << item.type << "\n";
+    cout << " Qty in Stock: " << item.quantity << "\n";
+    cout << " Batch ID    : " << item.batch << "\n";
+    cout << " Expiry Date : " << item.expiryDate << "\n";
     cout << "===============================================\n";
 
     int useQty;
@@ -231,33 +349,66 @@ void MedicalSupply::useLastAddedSupply() {
         cout << " Invalid input! Enter a number: ";
     }
 
-    if (useQty > item->quantity) {
-        cout << " Not enough quantity! Maximum available: " << item->quantity << "\n";
+    int left = 0;
+    if (useLast(useQty, &left) == OP_INSUFFICIENT) {
+        cout << " Not enough quantity! Maximum available: " << item.quantity << "\n";
         return;
     }
 
-    item->quantity -= useQty;
-
     cout << "\n========== SUPPLY USAGE TICKET ==========\n";
     cout << " Used Quantity : " << useQty << "\n";
-    cout << " Batch ID      : " << item->batch << "\n";
-    cout << " Type          : " << item->type << "\n";
+    cout << " Batch ID      : " << item.batch << "\n";
+    cout << " Type          : " << item.type << "\n";
     cout << "=========================================\n";
 
-    if (item->quantity == 0) {
+    if (left == 0) {
         cout << "\n----------------------------------------------\n";
-        cout << " The supply '" << item->type << "' (Batch " << item->batch 
+        cout << " The supply '" << item.type << "' (Batch " << item.batch 
              << ") has been completely used and removed from storage.\n";
         cout << "----------------------------------------------\n";
+    }
+}
 
-        top = top->next;
-        delete item;
-        itemCount--;
+// ==========================================================
+// DISPENSE BY TYPE
+// ==========================================================
+void MedicalSupply::dispenseSupply() {
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    string type;
+    int qty;
+
+    cout << "\n============ DISPENSE SUPPLY BY TYPE ============\n";
+    cout << " Enter supply type: ";
+    getline(cin, type);
+    while (type.empty()) {
+        cout << " Supply type cannot be empty. Enter supply type: ";
+        getline(cin, type);
+    }
+
+    cout << " Enter quantity to dispense: ";
+    while (!(cin >> qty) || qty <= 0) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << " Invalid input! Quantity must be a positive number: ";
+    }
+
+    int inStock = quantityOf(type);
+    OpStatus status = dispense(type, qty);
+    if (status == OP_NOT_FOUND) {
+        cout << " No '" << type << "' in storage.\n";
+    } else if (status == OP_INSUFFICIENT) {
+        cout << " Not enough '" << type << "'! Available across batches: " << inStock << "\n";
+    } else if (status != OP_OK) {
+        cout << " Could not dispense: " << opStatusText(status) << ".\n";
+    } else {
+        cout << " Dispensed " << qty << " x " << type << " (newest batches first), "
+             << inStock - qty << " left in storage.\n";
     }
 }
 
 // ==========================================================
-// REMOVE EXPIRED SUPPLIES (LINKED LIST TRAVERSAL)
+// REMOVE EXPIRED SUPPLIES
 // ==========================================================
 void MedicalSupply::removeExpiredSupplies() {
     if (isEmpty()) {
@@ -267,34 +418,12 @@ void MedicalSupply::removeExpiredSupplies() {
 
     cout << "\n============ REMOVE EXPIRED SUPPLIES ============\n";
 
-    SupplyItem* curr = top;
-    SupplyItem* prev = nullptr;
-    int removedCount = 0;
-
-    while (curr != nullptr) {
-        if (isDateExpired(curr->expiryDate)) {
-            cout << " [REMOVED] " << curr->type 
-                 << " (Batch " << curr->batch << ") — Expired on " 
-                 << curr->expiryDate << "\n";
-
-            removedCount++;
-
-            if (curr == top) {
-                top = curr->next;
-                delete curr;
-                curr = top;
-            } else {
-                prev->next = curr->next;
-                delete curr;
-                curr = prev->next;
-            }
-
-            itemCount--;
-        } 
-        else {
-            prev = curr;
-            curr = curr->next;
-        }
+    vector<SupplyItem> removed;
+    int removedCount = purgeExpired(&removed);
+    for (size_t i = 0; i < removed.size(); i++) {
+        cout << " [REMOVED] " << removed[i].type 
+             << " (Batch " << removed[i].batch << ") — Expired on " 
+             << removed[i].expiryDate << "\n";
     }
 
     if (removedCount == 0) {
@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include "OpStatus.hpp"
 using namespace std;
 
 // ======================================
@@ -32,10 +34,20 @@ public:
     MedicalSupply();
     ~MedicalSupply();
 
-    // Core operations
+    // Core API: no console I/O
+    OpStatus addStock(const string& type, int qty, const string& expiry,
+                      const string& remark, string* batchID = nullptr); // push
+    OpStatus useLast(int qty, int* left = nullptr);  // from the newest batch (pop when used up)
+    OpStatus dispense(const string& type, int qty);  // newest batches of `type` first
+    int purgeExpired(vector<SupplyItem>* removed = nullptr); // batches removed
+    int quantityOf(const string& type) const;
+    const SupplyItem* peekTop() const { return top; }
+
+    // Menu front-ends
     void menu();
     void addSupplyStock();
     void useLastAddedSupply();
+    void dispenseSupply();
     void viewCurrentSupplies();
     void removeExpiredSupplies();
 
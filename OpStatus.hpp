@@ -0,0 +1,29 @@
+#ifndef OP_STATUS_HPP
+#define OP_STATUS_HPP
+
+// Result of the console-free core operations of every role. The menus and
+// the batch runner turn it into text; the core never prints.
+enum OpStatus {
+    OP_OK = 0,
+    OP_INVALID_ARGUMENT, // missing or out-of-range input
+    OP_NOT_FOUND,        // no record with that ID
+    OP_DUPLICATE,        // ID already in use
+    OP_EMPTY,            // nothing to take from
+    OP_INSUFFICIENT,     // not enough quantity in stock
+    OP_UNAVAILABLE       // no unit in a state that allows it
+};
+
+inline const char* opStatusText(OpStatus status) {
+    switch (status) {
+        case OP_OK:               return "ok";
+        case OP_INVALID_ARGUMENT: return "invalid argument";
+        case OP_NOT_FOUND:        return "not found";
+        case OP_DUPLICATE:        return "already exists";
+        case OP_EMPTY:            return "empty";
+        case OP_INSUFFICIENT:     return "insufficient quantity";
+        case OP_UNAVAILABLE:      return "unavailable";
+    }
+    return "unknown";
+}
+
+#endif // OP_STATUS_HPP
@@ -1,4 +1,5 @@
 #include "PatientAdmission.hpp"
+#include "Instrumentation.hpp"
 #include <ctime>     // time, localtime, difftime
 #include <iomanip>   // put_time, setw, setfill
 #include <sstream>   // ostringstream
@@ -20,9 +21,6 @@ PatientQueue::PatientQueue() {
     rear = nullptr;
     size = 0;
     nextPatientNumber = 1;   // Start ID from P001
-
-    cout << "Patient Admission Manager initialized. "
-         << "Starting with an empty queue." << endl;
 }
 
 // ===========================================
@@ -35,7 +33,6 @@ PatientQueue::~PatientQueue() {
         current = current->nextAddress;
         delete temp;
     }
-    cout << "Patient queue destroyed and memory released." << endl;
 }
 
 // ===========================================
@@ -45,53 +42,33 @@ bool PatientQueue::isEmpty() {
     return (front == nullptr);
 }
 
+bool PatientQueue::isValidCondition(const string& conditionType) {
+    return conditionType == "Normal" || conditionType == "Critical" || conditionType == "Emergency";
+}
+
 // ==========================================================
-// 1) Admit Patient (AUTO ID)
+// Core API: Admit (AUTO ID), enqueue at the rear
 // ==========================================================
-void PatientQueue::admitPatient() {
-    PatientNode* newPatient = new PatientNode();
-
-    // Auto-generate unique Patient ID like P001, P002, ...
-    newPatient->patientID = generateNextPatientId();
-    cout << "\nGenerated Patient ID: " << newPatient->patientID << endl;
-
-    // Patient name
-    cout << "Enter Patient Name (can include spaces): ";
-    getline(cin, newPatient->name);
-    while (newPatient->name.empty()) {
-        cout << "Name cannot be empty. Enter name again: ";
-        getline(cin, newPatient->name);
+OpStatus PatientQueue::admit(PatientRecord& patient) {
+    HOSPITAL_TIMED(METRIC_ADMIT);
+    if (patient.name.empty() || !isValidCondition(patient.conditionType)) {
+        return OP_INVALID_ARGUMENT;
     }
 
-    // Condition type
-    int condChoice;
-    cout << "Select Condition Type:\n";
-    cout << "  1. Normal\n";
-    cout << "  2. Critical\n";
-    cout << "  3. Emergency\n";
-    cout << "Enter choice (1-3): ";
-    cin >> condChoice;
-
-    while (condChoice < 1 || condChoice > 3) {
-        cout << "Invalid choice. Enter 1-3: ";
-        cin >> condChoice;
-    }
-    cin.ignore();
-
-    switch (condChoice) {
-        case 1: newPatient->conditionType = "Normal"; break;
-        case 2: newPatient->conditionType = "Critical"; break;
-        case 3: newPatient->conditionType = "Emergency"; break;
-    }
+    // Auto-generate unique Patient ID like P001, P002, ...
+    patient.patientID = generateNextPatientId();
 
     // Time recorded
     time_t now = time(0);
-    newPatient->admittedTimeRaw = now;
+    patient.admittedTimeRaw = now;
     tm* localTime = localtime(&now);
 
     ostringstream oss;
     oss << put_time(localTime, "%Y-%m-%d %H:%M:%S");
-    newPatient->admittedAt = oss.str();
+    patient.admittedAt = oss.str();
+
+    PatientNode* newPatient = new PatientNode();
+    static_cast<PatientRecord&>(*newPatient) = patient;
 
     // Insert FIFO
     newPatient->nextAddress = nullptr;
@@ -106,17 +83,107 @@ void PatientQueue::admitPatient() {
     }
 
     size++;
+    return OP_OK;
+}
 
+// ==========================================================
+// Core API: Discharge (FIFO), dequeue the front
+// ==========================================================
+OpStatus PatientQueue::discharge(PatientRecord& discharged) {
+    HOSPITAL_TIMED(METRIC_DISCHARGE);
+    if (isEmpty()) {
+        return OP_EMPTY;
+    }
+
+    PatientNode* temp = front;
+    discharged = *temp;
+
+    front = front->nextAddress;
+    if (front != nullptr)
+        front->prevAddress = nullptr;
+    else
+        rear = nullptr;
+
+    delete temp;
+    size--;
+    return OP_OK;
+}
+
+// ==========================================================
+// Core API: Search by ID, Peek front
+// ==========================================================
+OpStatus PatientQueue::find(const string& id, PatientRecord& found) const {
+    for (const PatientNode* current = front; current != nullptr; current = current->nextAddress) {
+        if (current->patientID == id) {
+            found = *current;
+            return OP_OK;
+        }
+    }
+    return OP_NOT_FOUND;
+}
+
+OpStatus PatientQueue::peek(PatientRecord& next) const {
+    if (front == nullptr) {
+        return OP_EMPTY;
+    }
+    next = *front;
+    return OP_OK;
+}
+
+// ==========================================================
+// Ticket printed by the menu front-ends
+// ==========================================================
+static void printPatientTicket(const char* banner, const PatientRecord& p, bool showWaiting) {
     cout << "\n*************************************************" << endl;
-    cout << "*            NEW PATIENT ADMITTED                *" << endl;
+    cout << banner << endl;
     cout << "*************************************************" << endl;
-    cout << "*  Patient ID : " << newPatient->patientID << endl;
-    cout << "*  Name       : " << newPatient->name << endl;
-    cout << "*  Condition  : " << newPatient->conditionType << endl;
-    cout << "*  Admitted   : " << newPatient->admittedAt << endl;
+    cout << "*  Patient ID : " << p.patientID << endl;
+    cout << "*  Name       : " << p.name << endl;
+    cout << "*  Condition  : " << p.conditionType << endl;
+    cout << "*  Admitted   : " << p.admittedAt << endl;
+    if (showWaiting) {
+        int minutesWaited = (int)difftime(time(0), p.admittedTimeRaw) / 60;
+        cout << "*  Waiting    : " << minutesWaited << " minute(s)" << endl;
+    }
     cout << "*************************************************" << endl;
 }
 
+// ==========================================================
+// 1) Admit Patient (AUTO ID)
+// ==========================================================
+void PatientQueue::admitPatient() {
+    PatientRecord patient;
+
+    // Patient name
+    cout << "\nEnter Patient Name (can include spaces): ";
+    getline(cin, patient.name);
+    while (patient.name.empty()) {
+        cout << "Name cannot be empty. Enter name again: ";
+        getline(cin, patient.name);
+    }
+
+    // Condition type
+    int condChoice;
+    cout << "Select Condition Type:\n";
+    cout << "  1. Normal\n";
+    cout << "  2. Critical\n";
+    cout << "  3. Emergency\n";
+    cout << "Enter choice (1-3): ";
+    cin >> condChoice;
+
+    while (condChoice < 1 || condChoice > 3) {
+        cout << "Invalid choice. Enter 1-3: ";
+        cin >> condChoice;
+    }
+    cin.ignore();
+
+    const char* conditions[] = { "Normal", "Critical", "Emergency" };
+    patient.conditionType = conditions[condChoice - 1];
+    admit(patient);
+
+    printPatientTicket("*            NEW PATIENT ADMITTED                *", patient, false);
+}
+
 // ==========================================================
 // 2) Discharge (FIFO)
 // ==========================================================
@@ -129,31 +196,9 @@ void PatientQueue::dischargePatient() {
     cout << "\n===== BEFORE DISCHARGE =====" << endl;
     viewPatients();
 
-    PatientNode* temp = front;
-
-    // Waiting time
-    time_t now = time(0);
-    int minutesWaited = (int)difftime(now, temp->admittedTimeRaw) / 60;
-
-    cout << "\n*************************************************" << endl;
-    cout << "*              DISCHARGING PATIENT              *" << endl;
-    cout << "*************************************************" << endl;
-    cout << "*  Patient ID : " << temp->patientID << endl;
-    cout << "*  Name       : " << temp->name << endl;
-    cout << "*  Condition  : " << temp->conditionType << endl;
-    cout << "*  Admitted   : " << temp->admittedAt << endl;
-    cout << "*  Waiting    : " << minutesWaited << " minute(s)" << endl;
-    cout << "*************************************************" << endl;
-
-    // Remove the patient (FIFO)
-    front = front->nextAddress;
-    if (front != nullptr)
-        front->prevAddress = nullptr;
-    else
-        rear = nullptr;
-
-    delete temp;
-    size--;
+    PatientRecord discharged;
+    discharge(discharged);
+    printPatientTicket("*              DISCHARGING PATIENT              *", discharged, true);
 
     cout << "\n===== AFTER DISCHARGE =====" << endl;
     viewPatients();
@@ -170,31 +215,26 @@ void PatientQueue::viewPatients() {
 
     cout << "\n================ CURRENT PATIENT QUEUE ================" << endl;
 
-    PatientNode* current = front;
     int index = 1;
-
     int normal = 0, critical = 0, emergency = 0;
-
     time_t now = time(0);
 
-    while (current != nullptr) {
-        int minutesWaited = (int)difftime(now, current->admittedTimeRaw) / 60;
+    forEach([&](const PatientRecord& p) {
+        int minutesWaited = (int)difftime(now, p.admittedTimeRaw) / 60;
 
         cout << index << ") "
-             << "ID: " << current->patientID
-             << " | Name: " << current->name
-             << " | Condition: " << current->conditionType
-             << " | Admitted: " << current->admittedAt
+             << "ID: " << p.patientID
+             << " | Name: " << p.name
+             << " | Condition: " << p.conditionType
+             << " | Admitted: " << p.admittedAt
              << " | Waiting: " << minutesWaited << " mins"
              << endl;
 
-        if (current->conditionType == "Normal") normal++;
-        if (current->conditionType == "Critical") critical++;
-        if (current->conditionType == "Emergency") emergency++;
-
-        current = current->nextAddress;
+        if (p.conditionType == "Normal") normal++;
+        if (p.conditionType == "Critical") critical++;
+        if (p.conditionType == "Emergency") emergency++;
         index++;
-    }
+    });
 
     cout << "------------------------------------------------------" << endl;
     cout << "Summary -> Normal: " << normal
@@ -215,63 +255,30 @@ void PatientQueue::searchPatientById() {
     cout << "Enter Patient ID to search (e.g., P001): ";
     cin >> searchId;
 
-    PatientNode* current = front;
-    time_t now = time(0);
-
-    while (current != nullptr) {
-        if (current->patientID == searchId) {
-
-            int minutesWaited = (int)difftime(now, current->admittedTimeRaw) / 60;
-
-            cout << "\n*************************************************" << endl;
-            cout << "*                 PATIENT FOUND                 *" << endl;
-            cout << "*************************************************" << endl;
-            cout << "*  Patient ID : " << current->patientID << endl;
-            cout << "*  Name       : " << current->name << endl;
-            cout << "*  Condition  : " << current->conditionType << endl;
-            cout << "*  Admitted   : " << current->admittedAt << endl;
-            cout << "*  Waiting    : " << minutesWaited << " minute(s)" << endl;
-            cout << "*************************************************" << endl;
-
-            return;
-        }
-        current = current->nextAddress;
+    PatientRecord found;
+    if (find(searchId, found) != OP_OK) {
+        cout << "No patient found with ID: " << searchId << endl;
+        return;
     }
-
-    cout << "No patient found with ID: " << searchId << endl;
+    printPatientTicket("*                 PATIENT FOUND                 *", found, true);
 }
 
 // ==========================================================
 // 5) Peek next (front) patient
 // ==========================================================
 void PatientQueue::peekNextPatient() {
-    if (isEmpty()) {
+    PatientRecord next;
+    if (peek(next) != OP_OK) {
         cout << "No patients to peek." << endl;
         return;
     }
-
-    PatientNode* p = front;
-
-    time_t now = time(0);
-    int minutesWaited = (int)difftime(now, p->admittedTimeRaw) / 60;
-
-    cout << "\n*************************************************" << endl;
-    cout << "*             NEXT PATIENT (FRONT)              *" << endl;
-    cout << "*************************************************" << endl;
-    cout << "*  Patient ID : " << p->patientID << endl;
-    cout << "*  Name       : " << p->name << endl;
-    cout << "*  Condition  : " << p->conditionType << endl;
-    cout << "*  Admitted   : " << p->admittedAt << endl;
-    cout << "*  Waiting    : " << minutesWaited << " minute(s)" << endl;
-    cout << "*************************************************" << endl;
+    printPatientTicket("*             NEXT PATIENT (FRONT)              *", next, true);
 }
 
 // ==========================================================
 // MENU
 // ==========================================================
 void PatientAdmission::menu() {
-    PatientQueue patientQueue;
-
     int choice = 0;
     do {
         cout << "\n========================================================" << endl;
@@ -2,44 +2,74 @@
 #include <iostream>
 #include <string>
 #include <ctime>    // for time_t
+#include "OpStatus.hpp"
 using namespace std;
 
-// node structure for each patient in the queue (doubly linked list queue)
-struct PatientNode {
-    string patientID;           // unique ID entered by user
+// one patient, as handed to and returned by the PatientQueue API
+struct PatientRecord {
+    string patientID;           // auto-generated on admission (P001, P002, ...)
     string name;                // patient name
     string conditionType;       // Normal / Critical / Emergency
     string admittedAt;          // formatted admission time as text
     time_t admittedTimeRaw;     // raw admission timestamp for waiting time calc
+
+    PatientRecord() : admittedTimeRaw(0) {}
+    PatientRecord(const string& name, const string& conditionType)
+        : name(name), conditionType(conditionType), admittedTimeRaw(0) {}
+};
+
+// node structure for each patient in the queue (doubly linked list queue)
+struct PatientNode : PatientRecord {
     PatientNode* nextAddress;   //show next patient
     PatientNode* prevAddress;   //show previous patient
 };
 
 // PatientQueue class to manage the queue operations
 class PatientQueue {
-private: 
+private:
     PatientNode* front;
     PatientNode* rear;
     int size;
 
     int nextPatientNumber;          // counter for auto ID (1 -> P001, 2 -> P002, ...)
     string generateNextPatientId(); // helper to format ID22
-    
+
 public:
     PatientQueue();   // Constructor: initializes empty queue
     ~PatientQueue();  // Destructor: frees all nodes
 
     bool isEmpty();          // Check if the queue is empty
 
+    // Core API: no console I/O
+    OpStatus admit(PatientRecord& patient);         // enqueue; fills in patientID and admission time
+    OpStatus discharge(PatientRecord& discharged);  // dequeue the front patient (FIFO)
+    OpStatus find(const string& id, PatientRecord& found) const;
+    OpStatus peek(PatientRecord& next) const;
+    int count() const { return size; }
+
+    // Visit every patient from front to rear
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (const PatientNode* current = front; current != nullptr; current = current->nextAddress) {
+            visit(static_cast<const PatientRecord&>(*current));
+        }
+    }
+
+    static bool isValidCondition(const string& conditionType);
+
+    // Menu front-ends
     void admitPatient();     // 1. Add new patient to the rear of the queue
     void dischargePatient(); // 2. Remove (dequeue) the patient at the front
     void viewPatients();     // 3. Display all patients from front to rear
     void searchPatientById();// 4. Extra: search a patient by Patient ID
-    void peekNextPatient();   
-
+    void peekNextPatient();
 };
 
 class PatientAdmission {
+private:
+    PatientQueue patientQueue;  // kept across menu visits
+
 public:
     void menu();  // show patient admission menu and use PatientQueue inside
-};
\ No newline at end of file
+    PatientQueue& queue() { return patientQueue; }
+};
@@ -0,0 +1,491 @@
+#ifndef PRIORITY_QUEUE_HPP
+#define PRIORITY_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// ============================================================================
+// Policy-based d-ary heap
+// ----------------------------------------------------------------------------
+// PriorityQueue<T, KeyFn, Compare, Arity, Storage, Tracker>
+//   KeyFn    - functor returning the ordering key of a T
+//   Compare  - key comparison; std::less gives a max-heap (largest key on
+//              top), std::greater a min-heap, as with std::priority_queue
+//   Arity    - children per node; index arithmetic is resolved at compile
+//              time (shifts for powers of two)
+//   Storage  - InlineStorage (elements live in the heap array) or
+//              IndirectStorage (heap array holds 32-bit slot numbers into a
+//              stable pool, so sifting moves indices instead of elements)
+//   Tracker  - notified whenever an element lands on a new heap index or
+//              leaves the heap; NoPositionTracker compiles away
+//
+// Sifting uses the "hole" technique: the moving element is held aside and
+// each step is a single move instead of a swap.
+//
+// Capacity policy: doubles when full, pre-sized by reserve(), and halves
+// once usage drops to 25% (never below the initial or reserved capacity).
+// ============================================================================
+
+// Elements stored directly in heap order
+template <typename T>
+class InlineStorage {
+private:
+    T* data;
+    size_t count;
+    size_t allocated;
+
+public:
+    typedef T Slot;
+
+    explicit InlineStorage(size_t initialCapacity)
+        : data(new T[initialCapacity]), count(0), allocated(initialCapacity) {}
+
+    ~InlineStorage() {
+        delete[] data;
+    }
+
+    InlineStorage(const InlineStorage&) = delete;
+    InlineStorage& operator=(const InlineStorage&) = delete;
+
+    size_t size() const { return count; }
+    size_t capacity() const { return allocated; }
+    size_t elementCapacity() const { return allocated; }
+
+    const T& get(size_t index) const { return data[index]; }
+    const T& view(const Slot& slot) const { return slot; }
+
+    Slot take(size_t index) { return std::move(data[index]); }
+    void put(size_t index, Slot&& slot) { data[index] = std::move(slot); }
+
+    // Turn an element into a slot and back
+    Slot adopt(T&& value) { return std::move(value); }
+    T release(Slot&& slot) { return std::move(slot); }
+
+    void extend() { count++; }
+    void dropLast() { data[--count] = T(); }
+
+    // Move every element into an array of the new capacity
+    void relocate(size_t newCapacity) {
+        T* moved = new T[newCapacity];
+        for (size_t i = 0; i < count; i++) {
+            moved[i] = std::move(data[i]);
+        }
+        delete[] data;
+        data = moved;
+        allocated = newCapacity;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < count; i++) {
+            data[i] = T();
+        }
+        count = 0;
+    }
+};
+
+// Elements parked in a stable pool; the heap array orders 32-bit slot numbers.
+// The pool grows in fixed chunks, so elements never move once stored.
+template <typename T>
+class IndirectStorage {
+private:
+    static const size_t CHUNK_BITS = 8;
+    static const size_t CHUNK_SIZE = (size_t)1 << CHUNK_BITS;
+
+    vector<T*> chunks;
+    size_t poolUsed;            // slots handed out so far (including freed)
+    vector<uint32_t> freeSlots;
+    uint32_t* order;
+    size_t count;
+    size_t allocated;
+
+    T& poolAt(uint32_t slot) const {
+        return chunks[slot >> CHUNK_BITS][slot & (CHUNK_SIZE - 1)];
+    }
+
+    void releasePool() {
+        for (size_t i = 0; i < chunks.size(); i++) {
+            delete[] chunks[i];
+        }
+        vector<T*>().swap(chunks);
+        vector<uint32_t>().swap(freeSlots);
+        poolUsed = 0;
+    }
+
+    // Move live elements out of the trailing chunks into free slots of the
+    // leading ones, then free every chunk the live elements no longer need.
+    // Every slot below poolUsed is either live or free, so the leading
+    // chunks always have room.
+    void compactPool() {
+        size_t keepChunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        size_t limit = keepChunks * CHUNK_SIZE;
+        if (poolUsed <= limit) {
+            return;
+        }
+        vector<uint32_t> spare;
+        for (size_t i = 0; i < freeSlots.size(); i++) {
+            if (freeSlots[i] < limit) {
+                spare.push_back(freeSlots[i]);
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (order[i] >= limit) {
+                uint32_t target = spare.back();
+                spare.pop_back();
+                poolAt(target) = std::move(poolAt(order[i]));
+                order[i] = target;
+            }
+        }
+        for (size_t i = keepChunks; i < chunks.size(); i++) {
+            delete[] chunks[i];
+        }
+        chunks.resize(keepChunks);
+        vector<T*>(chunks).swap(chunks);
+        freeSlots.swap(spare);
+        vector<uint32_t>(freeSlots).swap(freeSlots);
+        poolUsed = limit;
+    }
+
+public:
+    typedef uint32_t Slot;
+
+    explicit IndirectStorage(size_t initialCapacity)
+        : poolUsed(0), order(new uint32_t[initialCapacity]), count(0), allocated(initialCapacity) {}
+
+    ~IndirectStorage() {
+        releasePool();
+        delete[] order;
+    }
+
+    IndirectStorage(const IndirectStorage&) = delete;
+    IndirectStorage& operator=(const IndirectStorage&) = delete;
+
+    size_t size() const { return count; }
+    size_t capacity() const { return allocated; }
+    size_t elementCapacity() const { return chunks.size() * CHUNK_SIZE; }
+
+    const T& get(size_t index) const { return poolAt(order[index]); }
+    const T& view(const Slot& slot) const { return poolAt(slot); }
+
+    Slot take(size_t index) { return order[index]; }
+    void put(size_t index, Slot&& slot) { order[index] = slot; }
+
+    Slot adopt(T&& value) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (poolUsed == chunks.size() * CHUNK_SIZE) {
+                chunks.push_back(new T[CHUNK_SIZE]);
+            }
+            slot = (uint32_t)poolUsed++;
+        }
+        poolAt(slot) = std::move(value);
+        return slot;
+    }
+
+    T release(Slot&& slot) {
+        T value = std::move(poolAt(slot));
+        poolAt(slot) = T();
+        freeSlots.push_back(slot);
+        return value;
+    }
+
+    void extend() { count++; }
+    void dropLast() { count--; }
+
+    void relocate(size_t newCapacity) {
+        bool shrinking = newCapacity < allocated;
+        uint32_t* moved = new uint32_t[newCapacity];
+        for (size_t i = 0; i < count; i++) {
+            moved[i] = order[i];
+        }
+        delete[] order;
+        order = moved;
+        allocated = newCapacity;
+
+        // Pool memory follows the heap back down on every shrink
+        if (shrinking) {
+            compactPool();
+        }
+    }
+
+    void clear() {
+        releasePool();
+        count = 0;
+    }
+};
+
+// Default tracker: nothing to record
+struct NoPositionTracker {
+    template <typename T>
+    void moved(const T&, size_t) {}
+
+    template <typename T>
+    void removed(const T&) {}
+
+    void clear() {}
+};
+
+template <typename T,
+          typename KeyFn,
+          typename Compare = less<typename decay<decltype(declval<KeyFn&>()(declval<const T&>()))>::type>,
+          unsigned Arity = 2,
+          template <typename> class Storage = InlineStorage,
+          typename Tracker = NoPositionTracker>
+class PriorityQueue {
+    static_assert(Arity >= 2, "PriorityQueue needs at least two children per node");
+
+private:
+    typedef Storage<T> StorageType;
+    typedef typename StorageType::Slot Slot;
+
+    StorageType store;
+    KeyFn keyOf;
+    Compare compare;
+    Tracker tracker;
+    size_t minCapacity;         // never shrink below the initial size
+    size_t reservedCapacity;    // floor held by reserve() until the surge arrives
+
+    static size_t parentOf(size_t index) { return (index - 1) / Arity; }
+    static size_t firstChildOf(size_t index) { return index * Arity + 1; }
+
+    template <bool Track>
+    void place(size_t index, Slot&& slot) {
+        store.put(index, std::move(slot));
+        if (Track) {
+            tracker.moved(store.get(index), index);
+        }
+    }
+
+    // Move the held element up from the hole at index
+    void siftUp(size_t index, Slot&& held) {
+        auto key = keyOf(store.view(held));
+        while (index > 0) {
+            size_t parent = parentOf(index);
+            if (!compare(keyOf(store.get(parent)), key)) {
+                break;
+            }
+            place<true>(index, store.take(parent));
+            index = parent;
+        }
+        place<true>(index, std::move(held));
+    }
+
+    // Move the held element down from the hole at index. Bulk rebuilds
+    // skip the tracker and report final positions once at the end.
+    template <bool Track = true>
+    void siftDown(size_t index, Slot&& held) {
+        auto key = keyOf(store.view(held));
+        size_t count = store.size();
+        for (;;) {
+            size_t first = firstChildOf(index);
+            if (first >= count) {
+                break;
+            }
+            size_t last = first + Arity < count ? first + Arity : count;
+            size_t best = first;
+            auto bestKey = keyOf(store.get(first));
+            for (size_t child = first + 1; child < last; child++) {
+                auto childKey = keyOf(store.get(child));
+                if (compare(bestKey, childKey)) {
+                    best = child;
+                    bestKey = childKey;
+                }
+            }
+            if (!compare(key, bestKey)) {
+                break;
+            }
+            place<Track>(index, store.take(best));
+            index = best;
+        }
+        place<Track>(index, std::move(held));
+    }
+
+    // Floyd's bottom-up rebuild of the first total elements, tracker
+    // untouched. Fewer than two elements are already a heap (and parentOf(0)
+    // would wrap).
+    void rebuild(size_t total) {
+        if (total < 2) {
+            return;
+        }
+        for (size_t i = parentOf(total - 1) + 1; i-- > 0;) {
+            siftDown<false>(i, store.take(i));
+        }
+    }
+
+    void growFor(size_t required) {
+        if (required <= store.capacity()) {
+            return;
+        }
+        size_t newCapacity = store.capacity();
+        while (newCapacity < required) {
+            newCapacity *= 2;
+        }
+        store.relocate(newCapacity);
+    }
+
+    void noteArrivals() {
+        if (reservedCapacity > 0 && store.size() * 2 >= reservedCapacity) {
+            reservedCapacity = 0;
+        }
+    }
+
+    // Grow at 100%, shrink by half at 25%, so a queue hovering around one
+    // size never flips between the two
+    void shrinkIfSparse() {
+        size_t floor = reservedCapacity > minCapacity ? reservedCapacity : minCapacity;
+        size_t capacity = store.capacity();
+        if (capacity <= floor || store.size() > capacity / 4) {
+            return;
+        }
+        size_t newCapacity = capacity / 2;
+        store.relocate(newCapacity < floor ? floor : newCapacity);
+    }
+
+public:
+    explicit PriorityQueue(size_t initialCapacity = 16,
+                           KeyFn key = KeyFn(), Compare cmp = Compare(), Tracker track = Tracker())
+        : store(initialCapacity > 0 ? initialCapacity : 1),
+          keyOf(key), compare(cmp), tracker(track),
+          minCapacity(initialCapacity > 0 ? initialCapacity : 1), reservedCapacity(0) {}
+
+    bool empty() const { return store.size() == 0; }
+    size_t size() const { return store.size(); }
+    size_t capacity() const { return store.capacity(); }
+    size_t elementCapacity() const { return store.elementCapacity(); } // elements the storage holds memory for
+
+    // Raw heap-order access (index 0 is the top)
+    const T& at(size_t index) const { return store.get(index); }
+
+    const T& top() const {
+        if (empty()) {
+            throw runtime_error("Priority queue is empty!");
+        }
+        return store.get(0);
+    }
+
+    static unsigned arity() { return Arity; }
+
+    Tracker& getTracker() { return tracker; }
+    const Tracker& getTracker() const { return tracker; }
+
+    // Pre-size before an expected surge; the reservation is held until the
+    // queue reaches half of it
+    void reserve(size_t expected) {
+        if (expected > store.capacity()) {
+            store.relocate(expected);
+        }
+        if (expected > reservedCapacity) {
+            reservedCapacity = expected;
+        }
+    }
+
+    void push(T value) {
+        growFor(store.size() + 1);
+        size_t index = store.size();
+        store.extend();
+        siftUp(index, store.adopt(std::move(value)));
+        noteArrivals();
+    }
+
+    T pop() {
+        if (empty()) {
+            throw runtime_error("Cannot extract from empty priority queue!");
+        }
+        Slot root = store.take(0);
+        size_t last = store.size() - 1;
+        if (last > 0) {
+            Slot moved = store.take(last);
+            store.dropLast();
+            siftDown<true>(0, std::move(moved));
+        } else {
+            store.dropLast();
+        }
+        tracker.removed(store.view(root));
+        T result = store.release(std::move(root));
+        shrinkIfSparse();
+        return result;
+    }
+
+    // Bulk insert. An empty heap is built bottom-up (Floyd, O(n)); for a
+    // non-empty heap the whole heap is rebuilt when the batch is large
+    // relative to it, otherwise each new element is sifted up.
+    template <typename Iterator>
+    void pushBatch(Iterator first, Iterator last) {
+        size_t batchSize = (size_t)std::distance(first, last);
+        if (batchSize == 0) {
+            return;
+        }
+        size_t existing = store.size();
+        size_t total = existing + batchSize;
+        growFor(total);
+
+        for (Iterator it = first; it != last; ++it) {
+            size_t index = store.size();
+            store.extend();
+            place<false>(index, store.adopt(T(*it)));
+        }
+        noteArrivals();
+
+        // Rebuild costs ~2n comparisons, per-element insertion ~k*log(n)
+        size_t depth = 1;
+        for (size_t span = Arity; span < total; span *= Arity) {
+            depth++;
+        }
+        if (existing == 0 || batchSize * depth > 2 * total) {
+            rebuild(total);
+            for (size_t i = 0; i < total; i++) {
+                tracker.moved(store.get(i), i);
+            }
+        } else {
+            for (size_t i = existing; i < total; i++) {
+                siftUp(i, store.take(i));
+            }
+        }
+    }
+
+    // Adopt elements that are already in heap order (e.g. a restored
+    // snapshot); next() is called total times and yields them in index
+    // order. The order is verified in one O(n) pass and rebuilt only if
+    // it does not hold; returns false in that case.
+    template <typename Source>
+    bool assignHeapOrder(size_t total, Source next) {
+        clear();
+        growFor(total);
+        for (size_t index = 0; index < total; index++) {
+            store.extend();
+            place<false>(index, store.adopt(next()));
+        }
+
+        bool valid = true;
+        for (size_t i = 1; i < total && valid; i++) {
+            valid = !compare(keyOf(store.get(parentOf(i))), keyOf(store.get(i)));
+        }
+        if (!valid) {
+            rebuild(total);
+        }
+        for (size_t i = 0; i < total; i++) {
+            tracker.moved(store.get(i), i);
+        }
+        return valid;
+    }
+
+    void clear() {
+        store.clear();
+        tracker.clear();
+        reservedCapacity = 0;
+        if (store.capacity() != minCapacity) {
+            store.relocate(minCapacity);
+        }
+    }
+};
+
+#endif // PRIORITY_QUEUE_HPP
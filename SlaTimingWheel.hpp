@@ -0,0 +1,215 @@
+#ifndef SLA_TIMING_WHEEL_HPP
+#define SLA_TIMING_WHEEL_HPP
+
+#include <ctime>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Hierarchical timing wheel for SLA (time-to-treatment) deadlines
+// - 4 levels x 64 slots at 1-second resolution (covers ~194 days ahead)
+// - schedule and cancel are O(1): timers sit in a pooled array and are
+//   chained into their slot with intrusive prev/next links
+// - advance() visits one level-0 slot per elapsed second and only touches
+//   timers that are due; higher levels cascade down every 64^k seconds
+class SlaTimingWheel {
+public:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+    struct Breach {
+        int caseID;
+        int priority;
+        time_t deadline;
+    };
+
+private:
+    struct Timer {
+        int caseID;
+        int priority;
+        time_t deadline;
+        int prev;
+        int next;                  // slot chain, or free list link
+        int level;
+        int slot;
+    };
+
+    vector<Timer> timers;
+    int freeHead;
+    int heads[LEVELS][SLOTS];
+    unordered_map<int, int> timerByCaseID;
+    time_t currentTime;            // last second processed
+
+    // cascading: called from advance() before the current level-0 slot is
+    // drained, so a timer due now can still fire this second
+    void link(int index, bool cascading = false) {
+        Timer& t = timers[index];
+        long long delta = (long long)(t.deadline - currentTime);
+
+        if (delta <= 0) {
+            // Already due: fire on the next second processed
+            t.level = 0;
+            t.slot = (int)((cascading ? currentTime : currentTime + 1) & (SLOTS - 1));
+        } else {
+            int level = 0;
+            while (level < LEVELS - 1 && delta >= (1LL << (SLOT_BITS * (level + 1)))) {
+                level++;
+            }
+            time_t due = t.deadline;
+            long long horizon = 1LL << (SLOT_BITS * LEVELS);
+            if (delta >= horizon) {
+                due = currentTime + (time_t)(horizon - 1);   // re-cascades later
+            }
+            t.level = level;
+            t.slot = (int)((due >> (SLOT_BITS * level)) & (SLOTS - 1));
+        }
+
+        t.prev = -1;
+        t.next = heads[t.level][t.slot];
+        if (t.next != -1) timers[t.next].prev = index;
+        heads[t.level][t.slot] = index;
+    }
+
+    void unlink(int index) {
+        Timer& t = timers[index];
+        if (t.prev != -1) timers[t.prev].next = t.next;
+        else heads[t.level][t.slot] = t.next;
+        if (t.next != -1) timers[t.next].prev = t.prev;
+    }
+
+    void freeTimer(int index) {
+        timerByCaseID.erase(timers[index].caseID);
+        timers[index].next = freeHead;
+        freeHead = index;
+    }
+
+    // Move every timer of a higher-level slot down to its new place
+    void cascade(int level, int slot) {
+        int index = heads[level][slot];
+        heads[level][slot] = -1;
+        while (index != -1) {
+            int next = timers[index].next;
+            link(index, true);
+            index = next;
+        }
+    }
+
+public:
+    explicit SlaTimingWheel(time_t start = time(0)) : freeHead(-1), currentTime(start) {
+        for (int l = 0; l < LEVELS; l++) {
+            for (int s = 0; s < SLOTS; s++) {
+                heads[l][s] = -1;
+            }
+        }
+    }
+
+    // Register (or re-register) a case deadline, O(1)
+    void schedule(int caseID, int priority, time_t deadline) {
+        cancel(caseID);
+
+        int index;
+        if (freeHead != -1) {
+            index = freeHead;
+            freeHead = timers[index].next;
+        } else {
+            index = (int)timers.size();
+            timers.push_back(Timer());
+        }
+
+        Timer& t = timers[index];
+        t.caseID = caseID;
+        t.priority = priority;
+        t.deadline = deadline;
+        link(index);
+        timerByCaseID[caseID] = index;
+    }
+
+    // Drop a case's deadline (e.g. it went into treatment), O(1)
+    bool cancel(int caseID) {
+        unordered_map<int, int>::iterator it = timerByCaseID.find(caseID);
+        if (it == timerByCaseID.end()) {
+            return false;
+        }
+        int index = it->second;
+        unlink(index);
+        freeTimer(index);
+        return true;
+    }
+
+    // Process every second up to now, appending expired deadlines to
+    // breaches. Returns the number of breaches found.
+    int advance(time_t now, vector<Breach>& breaches) {
+        int found = 0;
+
+        if (timerByCaseID.empty()) {
+            if (now > currentTime) currentTime = now;
+            return 0;
+        }
+
+        while (currentTime < now) {
+            currentTime++;
+
+            // Cascade higher levels whose slot boundary was just crossed
+            for (int level = 1; level < LEVELS; level++) {
+                if ((currentTime & ((1LL << (SLOT_BITS * level)) - 1)) != 0) {
+                    break;
+                }
+                cascade(level, (int)((currentTime >> (SLOT_BITS * level)) & (SLOTS - 1)));
+            }
+
+            int slot = (int)(currentTime & (SLOTS - 1));
+            int index = heads[0][slot];
+            heads[0][slot] = -1;
+            while (index != -1) {
+                int next = timers[index].next;
+                Timer& t = timers[index];
+                if (t.deadline <= currentTime) {
+                    Breach b;
+                    b.caseID = t.caseID;
+                    b.priority = t.priority;
+                    b.deadline = t.deadline;
+                    breaches.push_back(b);
+                    freeTimer(index);
+                    found++;
+                } else {
+                    link(index);
+                }
+                index = next;
+            }
+
+            if (timerByCaseID.empty()) {
+                currentTime = now;
+            }
+        }
+        return found;
+    }
+
+    // Pre-size for n timers, e.g. before re-registering a restored queue
+    void reserve(size_t n) {
+        timers.reserve(n);
+        timerByCaseID.reserve(n);
+    }
+
+    bool isScheduled(int caseID) const {
+        return timerByCaseID.count(caseID) > 0;
+    }
+
+    int size() const {
+        return (int)timerByCaseID.size();
+    }
+
+    void clear() {
+        vector<Timer>().swap(timers);
+        timerByCaseID.clear();
+        freeHead = -1;
+        for (int l = 0; l < LEVELS; l++) {
+            for (int s = 0; s < SLOTS; s++) {
+                heads[l][s] = -1;
+            }
+        }
+    }
+};
+
+#endif // SLA_TIMING_WHEEL_HPP
@@ -0,0 +1,86 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread.
+//
+// - Capacity is rounded up to a power of two; memory is allocated once.
+// - The producer owns `tail`, the consumer owns `head`. Each side keeps a
+//   cached copy of the other's index and only re-reads the shared atomic
+//   when the cache says the ring is full (producer) or empty (consumer).
+// - tryPush never blocks: a full ring returns false and the caller decides
+//   whether to drop or retry.
+template <typename T>
+class SpscRing {
+private:
+    vector<T> slots;
+    size_t mask;
+
+    alignas(64) atomic<size_t> head;   // next slot to read (consumer)
+    size_t cachedTail;                 // consumer's view of tail
+
+    alignas(64) atomic<size_t> tail;   // next slot to write (producer)
+    size_t cachedHead;                 // producer's view of head
+
+    static size_t roundUp(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) capacity <<= 1;
+        return capacity;
+    }
+
+public:
+    explicit SpscRing(size_t requestedCapacity = 4096)
+        : slots(roundUp(requestedCapacity)), mask(slots.size() - 1),
+          head(0), cachedTail(0), tail(0), cachedHead(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer only
+    bool tryPush(const T& item) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - cachedHead == slots.size()) {
+            cachedHead = head.load(memory_order_acquire);
+            if (t - cachedHead == slots.size()) {
+                return false;
+            }
+        }
+        slots[t & mask] = item;
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    // Consumer only: copy up to maxItems into out, returns how many
+    size_t popBatch(T* out, size_t maxItems) {
+        size_t h = head.load(memory_order_relaxed);
+        if (cachedTail == h) {
+            cachedTail = tail.load(memory_order_acquire);
+        }
+        size_t n = cachedTail - h;
+        if (n > maxItems) n = maxItems;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = slots[(h + i) & mask];
+        }
+        if (n > 0) {
+            head.store(h + n, memory_order_release);
+        }
+        return n;
+    }
+
+    // Items currently queued; exact only when called by producer or consumer
+    size_t approximateDepth() const {
+        return tail.load(memory_order_acquire) - head.load(memory_order_acquire);
+    }
+
+    size_t capacity() const {
+        return slots.size();
+    }
+};
+
+#endif // SPSC_RING_HPP
@@ -0,0 +1,212 @@
+#ifndef TREATMENT_SCHEDULER_HPP
+#define TREATMENT_SCHEDULER_HPP
+
+#include "EmergencyDepartment.hpp"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+// Hands called cases to parallel treatment teams.
+//
+// - Critical cases (priority >= threshold, default 8) stay in one shared,
+//   locked heap. Every team checks it before its own work, so the global
+//   heap feeds critical cases to whichever team frees up first.
+// - Urgent and standard cases are dealt round-robin into per-team deques
+//   (an urgent lane and a standard lane; the team drains urgent first and
+//   each lane is FIFO).
+// - A team with nothing left steals half of another team's backlog, taken
+//   from the back of the victim's lanes so the victim keeps working from the
+//   front undisturbed. Only one team lock is ever held at a time.
+//
+// Building block only: EmergencyDepartmentOfficer assigns called cases to
+// bays through BayAllocator and does not use this class. It is exercised by
+// bench/TreatmentSchedulerBench.cpp.
+class TreatmentScheduler {
+private:
+    enum { URGENT_LANE = 0, STANDARD_LANE = 1, LANE_COUNT = 2 };
+
+    struct Team {
+        mutex lock;
+        deque<EmergencyCase> lanes[LANE_COUNT];
+        atomic<int> backlog;       // read without the lock by thieves
+        char padding[64];          // keep neighbouring locks off one cache line
+
+        Team() : backlog(0) {}
+    };
+
+    int criticalThreshold;
+    mutex criticalLock;
+    EmergencyPriorityQueue criticalHeap;
+    atomic<int> criticalPending;
+
+    vector<Team*> teams;
+    atomic<unsigned> nextTeam;
+    atomic<long long> steals;
+
+    static int laneOf(int priority) {
+        return priority >= 5 ? URGENT_LANE : STANDARD_LANE;
+    }
+
+    bool takeCritical(EmergencyCase& out) {
+        if (criticalPending.load(memory_order_acquire) == 0) {
+            return false;
+        }
+        lock_guard<mutex> guard(criticalLock);
+        if (criticalHeap.isEmpty()) {
+            return false;
+        }
+        out = criticalHeap.extractMostCritical();
+        criticalPending.fetch_sub(1);
+        return true;
+    }
+
+    bool takeOwn(Team& team, EmergencyCase& out) {
+        if (team.backlog.load(memory_order_acquire) == 0) {
+            return false;
+        }
+        lock_guard<mutex> guard(team.lock);
+        for (int lane = 0; lane < LANE_COUNT; lane++) {
+            if (!team.lanes[lane].empty()) {
+                out = std::move(team.lanes[lane].front());
+                team.lanes[lane].pop_front();
+                team.backlog.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Move half of the busiest other team's backlog into team `thief`
+    bool steal(int thief, EmergencyCase& out) {
+        int teamCount = (int)teams.size();
+        int victim = -1;
+        int most = 0;
+        for (int k = 1; k < teamCount; k++) {
+            int candidate = (thief + k) % teamCount;
+            int backlog = teams[candidate]->backlog.load(memory_order_relaxed);
+            if (backlog > most) {
+                most = backlog;
+                victim = candidate;
+            }
+        }
+        if (victim == -1) {
+            return false;
+        }
+
+        vector<EmergencyCase> loot[LANE_COUNT];
+        {
+            Team& from = *teams[victim];
+            lock_guard<mutex> guard(from.lock);
+            int total = (int)(from.lanes[URGENT_LANE].size() + from.lanes[STANDARD_LANE].size());
+            int wanted = (total + 1) / 2;
+            for (int lane = STANDARD_LANE; lane >= URGENT_LANE && wanted > 0; lane--) {
+                while (wanted > 0 && !from.lanes[lane].empty()) {
+                    loot[lane].push_back(std::move(from.lanes[lane].back()));
+                    from.lanes[lane].pop_back();
+                    wanted--;
+                }
+            }
+            from.backlog.fetch_sub((int)(loot[URGENT_LANE].size() + loot[STANDARD_LANE].size()));
+        }
+
+        int taken = (int)(loot[URGENT_LANE].size() + loot[STANDARD_LANE].size());
+        if (taken == 0) {
+            return false;
+        }
+        steals.fetch_add(1, memory_order_relaxed);
+
+        // Keep the urgent case for now, file the rest in the thief's own lanes
+        // in their original order (loot was collected back to front)
+        int keepLane = loot[URGENT_LANE].empty() ? STANDARD_LANE : URGENT_LANE;
+        out = std::move(loot[keepLane].back());
+        loot[keepLane].pop_back();
+
+        Team& to = *teams[thief];
+        lock_guard<mutex> guard(to.lock);
+        for (int lane = 0; lane < LANE_COUNT; lane++) {
+            for (size_t i = loot[lane].size(); i-- > 0;) {
+                to.lanes[lane].push_back(std::move(loot[lane][i]));
+            }
+        }
+        to.backlog.fetch_add(taken - 1);
+        return true;
+    }
+
+public:
+    TreatmentScheduler(int teamCount = 4, int threshold = 8)
+        : criticalThreshold(threshold), criticalHeap(64), criticalPending(0), nextTeam(0), steals(0) {
+        if (teamCount < 1) teamCount = 1;
+        for (int i = 0; i < teamCount; i++) {
+            teams.push_back(new Team());
+        }
+    }
+
+    ~TreatmentScheduler() {
+        for (size_t i = 0; i < teams.size(); i++) {
+            delete teams[i];
+        }
+    }
+
+    TreatmentScheduler(const TreatmentScheduler&) = delete;
+    TreatmentScheduler& operator=(const TreatmentScheduler&) = delete;
+
+    // Hand a called case to the teams; safe from any thread
+    void submit(const EmergencyCase& c) {
+        if (c.priorityLevel >= criticalThreshold) {
+            lock_guard<mutex> guard(criticalLock);
+            criticalHeap.insertEmergencyCase(c);
+            criticalPending.fetch_add(1, memory_order_release);
+            return;
+        }
+        Team& team = *teams[nextTeam.fetch_add(1, memory_order_relaxed) % teams.size()];
+        lock_guard<mutex> guard(team.lock);
+        team.lanes[laneOf(c.priorityLevel)].push_back(c);
+        team.backlog.fetch_add(1, memory_order_release);
+    }
+
+    // Move up to maxCases from the officer's pending heap, most critical first
+    int submitFrom(EmergencyPriorityQueue& pending, int maxCases) {
+        int moved = 0;
+        while (moved < maxCases && !pending.isEmpty()) {
+            submit(pending.extractMostCritical());
+            moved++;
+        }
+        return moved;
+    }
+
+    // Next case for a team: shared critical heap, own deque, then steal.
+    // Returns false when there is nothing anywhere right now.
+    bool next(int team, EmergencyCase& out) {
+        return takeCritical(out) || takeOwn(*teams[team], out) || steal(team, out);
+    }
+
+    // Cases not yet picked up by any team (may be stale under concurrency)
+    int approximateBacklog() const {
+        int total = criticalPending.load(memory_order_relaxed);
+        for (size_t i = 0; i < teams.size(); i++) {
+            total += teams[i]->backlog.load(memory_order_relaxed);
+        }
+        return total;
+    }
+
+    int getTeamBacklog(int team) const {
+        return teams[team]->backlog.load(memory_order_relaxed);
+    }
+
+    int getTeamCount() const {
+        return (int)teams.size();
+    }
+
+    long long getStealCount() const {
+        return steals.load(memory_order_relaxed);
+    }
+
+    int getCriticalThreshold() const {
+        return criticalThreshold;
+    }
+};
+
+#endif // TREATMENT_SCHEDULER_HPP
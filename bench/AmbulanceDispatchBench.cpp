@@ -0,0 +1,167 @@
+// ============================================================================
+// AmbulanceDispatchBench.cpp
+// Nearest-available query latency on the ambulance grid index
+// ----------------------------------------------------------------------------
+// 10^4 units spread over a 60 x 60 km region, ~75% Available. Each simulated
+// second applies 1000 position updates (units drift up to 0.5 km), 20 status
+// changes (dispatch / return to Available), then runs incident queries for
+// k = 1 and k = 5. Every query result is checked against a brute-force scan
+// of all Available units. A three-unit fleet with one unit far out then
+// checks k above the unit count, a far-off query point and rejected positions.
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/AmbulanceDispatchBench.cpp Ambulance.cpp -o ambulance_dispatch_bench
+// Usage: ./ambulance_dispatch_bench [units=10000] [seconds=20] [queriesPerSecond=2000]
+// ============================================================================
+
+#include "../Ambulance.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static const double REGION_KM = 60.0;
+
+struct UnitState {
+    string id;
+    double x, y;
+    bool available;
+};
+
+static unsigned seed = 8675309u;
+
+static double uniform01() {
+    seed = seed * 1103515245u + 12345u;
+    return ((seed >> 8) & 0xFFFFFF) / (double)0x1000000;
+}
+
+static vector<double> bruteForce(const vector<UnitState>& units, double x, double y, int k) {
+    vector<double> d;
+    for (size_t i = 0; i < units.size(); i++) {
+        if (units[i].available) d.push_back(hypot(units[i].x - x, units[i].y - y));
+    }
+    sort(d.begin(), d.end());
+    if ((int)d.size() > k) d.resize(k);
+    return d;
+}
+
+static double percentile(vector<double>& values, double p) {
+    if (values.empty()) return 0;
+    size_t rank = (size_t)(p * (values.size() - 1));
+    nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+// Each of these used to scan every ring out to the outlier (or overflow)
+static bool sparseFleetOk() {
+    AmbulanceQueue fleet;
+    for (int i = 0; i < 3; i++) {
+        fleet.addAmbulance("E" + to_string(i), "Driver " + to_string(i));
+        fleet.setPosition("E" + to_string(i), i, i);
+    }
+    bool ok = fleet.setPosition("E0", NAN, 0) == OP_INVALID_ARGUMENT &&
+              fleet.setPosition("E0", 1e300, 0) == OP_INVALID_ARGUMENT;
+
+    ok = ok && fleet.setPosition("E2", 900000.0, 900000.0) == OP_OK;
+    vector<NearbyUnit> found = fleet.nearestAvailable(0, 0, 10);
+    ok = ok && found.size() == 3 && found[0].id == "E0" && found[2].id == "E2";
+
+    // Back home; the bounds shrink again
+    ok = ok && fleet.setPosition("E2", 2, 2) == OP_OK;
+    found = fleet.nearestAvailable(1e12, -1e12, 10);
+    ok = ok && found.size() == 3 && found[0].distance <= found[2].distance;
+    found = fleet.nearestAvailable(1.9, 1.9, 1);
+    return ok && found.size() == 1 && found[0].id == "E2";
+}
+
+int main(int argc, char* argv[]) {
+    int unitCount = (argc > 1) ? atoi(argv[1]) : 10000;
+    int seconds = (argc > 2) ? atoi(argv[2]) : 20;
+    int queriesPerSecond = (argc > 3) ? atoi(argv[3]) : 2000;
+    if (unitCount <= 0) unitCount = 10000;
+    if (seconds <= 0) seconds = 20;
+    if (queriesPerSecond <= 0) queriesPerSecond = 2000;
+
+    AmbulanceQueue fleet;
+    vector<UnitState> units(unitCount);
+    for (int i = 0; i < unitCount; i++) {
+        units[i].id = "AMB" + to_string(i);
+        units[i].x = uniform01() * REGION_KM;
+        units[i].y = uniform01() * REGION_KM;
+        units[i].available = uniform01() < 0.75;
+        fleet.addAmbulance(units[i].id, "Driver " + to_string(i));
+        fleet.setPosition(units[i].id, units[i].x, units[i].y);
+        if (!units[i].available) fleet.setStatus(units[i].id, STATUS_ON_DUTY);
+    }
+
+    const int ks[] = { 1, 5 };
+    vector<double> latencyUs[2];
+    double updateNs = 0;
+    double bruteUs = 0;
+    long long updates = 0;
+    long long bruteQueries = 0;
+    bool ok = sparseFleetOk();
+
+    for (int s = 0; s < seconds; s++) {
+        steady_clock::time_point t0 = steady_clock::now();
+        for (int u = 0; u < 1000; u++) {
+            UnitState& unit = units[(size_t)(uniform01() * unitCount)];
+            unit.x = min(REGION_KM, max(0.0, unit.x + (uniform01() - 0.5)));
+            unit.y = min(REGION_KM, max(0.0, unit.y + (uniform01() - 0.5)));
+            fleet.setPosition(unit.id, unit.x, unit.y);
+        }
+        updateNs += duration<double, nano>(steady_clock::now() - t0).count();
+        updates += 1000;
+
+        for (int c = 0; c < 20; c++) {
+            UnitState& unit = units[(size_t)(uniform01() * unitCount)];
+            unit.available = !unit.available;
+            fleet.setStatus(unit.id, unit.available ? STATUS_AVAILABLE : STATUS_ON_DUTY);
+        }
+
+        for (int q = 0; q < queriesPerSecond; q++) {
+            int which = q & 1;
+            double x = uniform01() * REGION_KM;
+            double y = uniform01() * REGION_KM;
+
+            steady_clock::time_point start = steady_clock::now();
+            vector<NearbyUnit> found = fleet.nearestAvailable(x, y, ks[which]);
+            latencyUs[which].push_back(duration<double, micro>(steady_clock::now() - start).count());
+
+            if (q % 50 == 0) {
+                steady_clock::time_point bruteStart = steady_clock::now();
+                vector<double> expected = bruteForce(units, x, y, ks[which]);
+                bruteUs += duration<double, micro>(steady_clock::now() - bruteStart).count();
+                bruteQueries++;
+
+                ok = ok && expected.size() == found.size();
+                for (size_t i = 0; ok && i < found.size(); i++) {
+                    Ambulance unit;
+                    ok = fabs(expected[i] - found[i].distance) < 1e-9 &&
+                         fleet.getUnit(found[i].id, unit) == OP_OK && unit.status == STATUS_AVAILABLE;
+                }
+            }
+        }
+    }
+
+    cout << "Nearest-available dispatch: " << unitCount << " units, " << fleet.countByStatus(STATUS_AVAILABLE)
+         << " available, " << seconds << " s simulated, 1000 position updates/s\n";
+    cout << fixed << setprecision(2);
+    cout << left << setw(10) << "query" << right << setw(12) << "p50 us" << setw(12) << "p99 us"
+         << setw(12) << "max us" << endl;
+    for (int i = 0; i < 2; i++) {
+        double maxUs = *max_element(latencyUs[i].begin(), latencyUs[i].end());
+        cout << left << setw(10) << ("k=" + to_string(ks[i])) << right
+             << setw(12) << percentile(latencyUs[i], 0.50) << setw(12) << percentile(latencyUs[i], 0.99)
+             << setw(12) << maxUs << endl;
+    }
+    cout << "position update: " << updateNs / updates << " ns avg\n";
+    cout << "brute-force scan: " << bruteUs / bruteQueries << " us avg\n";
+    cout << "result check: " << (ok ? "ok" : "FAILED") << endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+// ============================================================================
+// AmbulanceRemovalBench.cpp
+// Decommissioning cost: O(1) tombstone removal vs predecessor search
+// ----------------------------------------------------------------------------
+// Correctness: a random mix of registrations, rotations and removals (front,
+// rear, interior, and emptying the fleet completely) is checked against a
+// std::deque model after every step: rotation order, size and per-status
+// counts must match.
+//
+// Timing: register N units, then decommission them all in random order.
+//   ring buffer  → AmbulanceQueue::removeAmbulance
+//   linked ring  → the old singly linked ring, which must walk from the
+//                  front to find the predecessor of the removed unit
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/AmbulanceRemovalBench.cpp Ambulance.cpp -o ambulance_removal_bench
+// Usage: ./ambulance_removal_bench [maxUnits=16000]
+// ============================================================================
+
+#include "../Ambulance.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static unsigned seed = 1234567u;
+
+static unsigned nextRandom()
+{
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+// Reference: singly linked ring, removal searches for the predecessor
+class LinkedRing
+{
+private:
+    struct Node
+    {
+        string id;
+        Node* next;
+    };
+    Node* front;
+    Node* rear;
+    unordered_map<string, Node*> byID;
+
+public:
+    LinkedRing() : front(nullptr), rear(nullptr) {}
+
+    ~LinkedRing()
+    {
+        while (front != nullptr)
+            remove(front->id);
+    }
+
+    void add(const string& id)
+    {
+        Node* node = new Node();
+        node->id = id;
+        if (front == nullptr)
+            front = rear = node;
+        else
+        {
+            rear->next = node;
+            rear = node;
+        }
+        rear->next = front;
+        byID[id] = node;
+    }
+
+    bool remove(const string& id)
+    {
+        unordered_map<string, Node*>::iterator it = byID.find(id);
+        if (it == byID.end())
+            return false;
+        Node* node = it->second;
+        byID.erase(it);
+
+        if (node->next == node)
+        {
+            front = rear = nullptr;
+        }
+        else
+        {
+            Node* prev = front;
+            while (prev->next != node)
+                prev = prev->next;
+            prev->next = node->next;
+            if (node == front)
+                front = node->next;
+            if (node == rear)
+                rear = prev;
+        }
+        delete node;
+        return true;
+    }
+};
+
+static bool sameAsModel(const AmbulanceQueue& fleet, const deque<string>& model, const int statusModel[])
+{
+    if (fleet.size() != (int)model.size())
+        return false;
+    size_t i = 0;
+    bool same = true;
+    fleet.forEachInRotation([&](const Ambulance& unit) {
+        same = same && i < model.size() && unit.id == model[i];
+        i++;
+    });
+    for (int s = 0; s < STATUS_COUNT; s++)
+        same = same && fleet.countByStatus((AmbulanceStatus)s) == statusModel[s];
+    return same && i == model.size();
+}
+
+static bool stressCheck(int steps)
+{
+    AmbulanceQueue fleet;
+    deque<string> model;
+    unordered_map<string, AmbulanceStatus> statusOf;
+    int statusModel[STATUS_COUNT] = { 0, 0, 0 };
+    int nextID = 0;
+    streambuf* saved = cout.rdbuf(nullptr); // rotateShift reports on stdout
+
+    bool ok = true;
+    for (int step = 0; step < steps && ok; step++)
+    {
+        unsigned roll = nextRandom() % 100;
+        // Phases: grow to a few hundred units, then drain to empty, repeat
+        bool draining = (step / 3000) % 2 == 1;
+        if (!model.empty() && (roll < (draining ? 60u : 25u)))
+        {
+            // Remove front, rear or an interior unit
+            size_t pick = roll % 3 == 0 ? 0 : (roll % 3 == 1 ? model.size() - 1 : nextRandom() % model.size());
+            string id = model[pick];
+            model.erase(model.begin() + pick);
+            statusModel[statusOf[id]]--;
+            statusOf.erase(id);
+            ok = fleet.removeAmbulance(id) == OP_OK && fleet.removeAmbulance(id) == OP_NOT_FOUND;
+        }
+        else if (!model.empty() && roll < 70)
+        {
+            fleet.rotateShift();
+            model.push_back(model.front());
+            model.pop_front();
+        }
+        else if (!model.empty() && roll < 80)
+        {
+            string id = model[nextRandom() % model.size()];
+            AmbulanceStatus status = (AmbulanceStatus)(nextRandom() % STATUS_COUNT);
+            statusModel[statusOf[id]]--;
+            statusModel[status]++;
+            statusOf[id] = status;
+            fleet.setStatus(id, status);
+        }
+        else if (!draining || model.empty())
+        {
+            string id = "AMB" + to_string(nextID++);
+            fleet.addAmbulance(id, "Driver");
+            model.push_back(id);
+            statusOf[id] = STATUS_AVAILABLE;
+            statusModel[STATUS_AVAILABLE]++;
+        }
+        ok = ok && sameAsModel(fleet, model, statusModel) && fleet.isEmpty() == model.empty();
+    }
+    cout.rdbuf(saved);
+    return ok;
+}
+
+int main(int argc, char* argv[])
+{
+    int maxUnits = (argc > 1) ? atoi(argv[1]) : 16000;
+    if (maxUnits < 1000)
+        maxUnits = 16000;
+
+    bool ok = stressCheck(60000);
+    cout << "Decommission every unit in random order, ns per removal\n";
+    cout << left << setw(10) << "units" << right << setw(14) << "ring buffer" << setw(14) << "linked ring" << endl;
+    cout << fixed << setprecision(1);
+
+    for (int units = 1000; units <= maxUnits; units *= 4)
+    {
+        vector<string> ids;
+        for (int i = 0; i < units; i++)
+            ids.push_back("AMB" + to_string(i));
+        vector<string> order = ids;
+        for (size_t i = order.size(); i > 1; i--)
+            swap(order[i - 1], order[nextRandom() % i]);
+
+        AmbulanceQueue fleet;
+        LinkedRing linked;
+        for (int i = 0; i < units; i++)
+        {
+            fleet.addAmbulance(ids[i], "Driver");
+            linked.add(ids[i]);
+        }
+
+        steady_clock::time_point t0 = steady_clock::now();
+        for (int i = 0; i < units; i++)
+            ok = fleet.removeAmbulance(order[i]) == OP_OK && ok;
+        double ringNs = duration<double, nano>(steady_clock::now() - t0).count() / units;
+        ok = ok && fleet.isEmpty();
+
+        t0 = steady_clock::now();
+        for (int i = 0; i < units; i++)
+            ok = linked.remove(order[i]) && ok;
+        double linkedNs = duration<double, nano>(steady_clock::now() - t0).count() / units;
+
+        cout << left << setw(10) << units << right << setw(14) << ringNs << setw(14) << linkedNs << endl;
+    }
+    cout << "model check: " << (ok ? "ok" : "FAILED") << endl;
+
+    return ok ? 0 : 1;
+}
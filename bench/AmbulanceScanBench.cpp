@@ -0,0 +1,189 @@
+// ============================================================================
+// AmbulanceScanBench.cpp
+// Full-fleet scan cost: linked ring of heap nodes vs ring buffer of handles
+// ----------------------------------------------------------------------------
+// Each scan walks the whole rotation from front to rear and reads the status
+// and ID of every unit (what displaySchedule and a status report do).
+//
+//   linked (fresh)   → the old layout: one `new Ambulance` per unit linked
+//                      through `next`, registered back to back
+//   linked (churned) → same, but other allocations are interleaved with the
+//                      registrations (and half of them freed again), as in a
+//                      long-running process where units join over time
+//   ring buffer      → AmbulanceQueue: deque-backed records, rotation as a
+//                      contiguous circular buffer of handles
+// The fleet is rotated a few times between scans. Every scan must see the
+// same number of Available units in all three layouts.
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/AmbulanceScanBench.cpp Ambulance.cpp -o ambulance_scan_bench
+// Usage: ./ambulance_scan_bench [maxUnits=1000000]
+// ============================================================================
+
+#include "../Ambulance.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+// Reference: the layout AmbulanceQueue used before the ring buffer
+struct LinkedUnit
+{
+    string id;
+    string driverName;
+    AmbulanceStatus status;
+    LinkedUnit* next;
+    Ambulance* statusPrev;
+    Ambulance* statusNext;
+    double x, y;
+    bool hasPosition;
+    long long gridCell;
+    int gridSlot;
+};
+
+class LinkedRing
+{
+private:
+    LinkedUnit* front;
+    LinkedUnit* rear;
+    vector<char*> filler;
+
+public:
+    LinkedRing() : front(nullptr), rear(nullptr) {}
+
+    ~LinkedRing()
+    {
+        if (front != nullptr)
+        {
+            LinkedUnit* temp = front;
+            do
+            {
+                LinkedUnit* del = temp;
+                temp = temp->next;
+                delete del;
+            } while (temp != front);
+        }
+        for (size_t i = 0; i < filler.size(); i++)
+            delete[] filler[i];
+    }
+
+    void add(const string& id, AmbulanceStatus status, unsigned churn)
+    {
+        // Churned heaps: something else allocated between registrations
+        if (churn != 0)
+        {
+            filler.push_back(new char[32 + churn % 480]);
+            if (churn & 1)
+            {
+                delete[] filler[churn % filler.size()];
+                filler[churn % filler.size()] = filler.back();
+                filler.pop_back();
+            }
+        }
+
+        LinkedUnit* node = new LinkedUnit();
+        node->id = id;
+        node->driverName = "Driver " + id;
+        node->status = status;
+        if (front == nullptr)
+        {
+            front = rear = node;
+        }
+        else
+        {
+            rear->next = node;
+            rear = node;
+        }
+        rear->next = front;
+    }
+
+    void rotate()
+    {
+        front = front->next;
+        rear = rear->next;
+    }
+
+    long long scan() const
+    {
+        long long available = 0;
+        const LinkedUnit* temp = front;
+        do
+        {
+            available += (temp->status == STATUS_AVAILABLE) + (temp->id.size() == 0);
+            temp = temp->next;
+        } while (temp != front);
+        return available;
+    }
+};
+
+static long long scanQueue(const AmbulanceQueue& fleet)
+{
+    long long available = 0;
+    fleet.forEachInRotation([&available](const Ambulance& unit) {
+        available += (unit.status == STATUS_AVAILABLE) + (unit.id.size() == 0);
+    });
+    return available;
+}
+
+template <typename Scan, typename Rotate>
+static double nsPerUnit(int units, int scans, Scan scan, Rotate rotate, long long& checksum)
+{
+    checksum = 0;
+    steady_clock::time_point t0 = steady_clock::now();
+    for (int s = 0; s < scans; s++)
+    {
+        checksum += scan();
+        for (int r = 0; r < 3; r++)
+            rotate();
+    }
+    return duration<double, nano>(steady_clock::now() - t0).count() / ((double)units * scans);
+}
+
+int main(int argc, char* argv[])
+{
+    int maxUnits = (argc > 1) ? atoi(argv[1]) : 1000000;
+    if (maxUnits < 1000)
+        maxUnits = 1000000;
+
+    bool ok = true;
+    cout << "Full-fleet scan, ns per unit visited\n";
+    cout << left << setw(10) << "units" << right << setw(16) << "linked fresh" << setw(18)
+         << "linked churned" << setw(14) << "ring buffer" << endl;
+    cout << fixed << setprecision(2);
+
+    for (int units = 1000; units <= maxUnits; units *= 10)
+    {
+        int scans = max(5, 20000000 / units);
+        LinkedRing fresh, churned;
+        AmbulanceQueue fleet;
+        unsigned seed = 2024u;
+        for (int i = 0; i < units; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            AmbulanceStatus status = (seed >> 16) % 10 < 7 ? STATUS_AVAILABLE : STATUS_ON_DUTY;
+            string id = "AMB" + to_string(i);
+            fresh.add(id, status, 0);
+            churned.add(id, status, (seed >> 8) | 2u);
+            fleet.addAmbulance(id, "Driver " + id);
+            if (status != STATUS_AVAILABLE)
+                fleet.setStatus(id, status);
+        }
+
+        // rotateShift reports on stdout; silence it for the timed loop
+        streambuf* saved = cout.rdbuf(nullptr);
+        long long freshSum, churnedSum, ringSum;
+        double freshNs = nsPerUnit(units, scans, [&] { return fresh.scan(); }, [&] { fresh.rotate(); }, freshSum);
+        double churnedNs = nsPerUnit(units, scans, [&] { return churned.scan(); }, [&] { churned.rotate(); }, churnedSum);
+        double ringNs = nsPerUnit(units, scans, [&] { return scanQueue(fleet); }, [&] { fleet.rotateShift(); }, ringSum);
+        cout.rdbuf(saved);
+
+        ok = ok && freshSum == churnedSum && freshSum == ringSum;
+        cout << left << setw(10) << units << right << setw(16) << freshNs << setw(18) << churnedNs
+             << setw(14) << ringNs << endl;
+    }
+    cout << "scan check: " << (ok ? "ok" : "FAILED") << endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+// ============================================================================
+// AutoDispatchBench.cpp
+// ED case logged → ambulance reserved, through the EventBus
+// ----------------------------------------------------------------------------
+// An EmergencyDepartmentOfficer logs cases with logCase at a fixed rate
+// (priorities 1-10, so about 30% reach the dispatch threshold of 8). An
+// AutoDispatcher reserves a unit for each critical case on its own thread.
+// A crew thread listens for EVENT_AMBULANCE_ASSIGNED and brings units back
+// (Available again) once half the fleet is out, so the fleet never runs dry.
+//
+//   latency  → EventBus::nowNs() at publish to the unit being reserved
+//   checks   → every critical case gets exactly one outcome, no unit is
+//              assigned while the crew still holds it, no dispatch failures
+// The "+telemetry" row adds a thread moving units with setPosition, which
+// contends for the same fleet lock.
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/AutoDispatchBench.cpp Ambulance.cpp -o auto_dispatch_bench
+// Usage: ./auto_dispatch_bench [units=2000] [secondsPerRate=1]
+// ============================================================================
+
+#include "../EmergencyDepartment.hpp"
+#include "../AutoDispatch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <thread>
+#include <unordered_set>
+
+using namespace std;
+using namespace std::chrono;
+
+static double percentileUs(vector<long long>& values, double p)
+{
+    if (values.empty())
+        return 0;
+    size_t rank = (size_t)(p * (values.size() - 1));
+    nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank] / 1000.0;
+}
+
+struct RunResult
+{
+    long long critical;
+    long long assigned;
+    long long failed;
+    long long doubleAssigned;
+    double achievedRate;
+    vector<long long> latencyNs;
+};
+
+static RunResult run(int units, double casesPerSecond, double seconds, bool telemetryLoad)
+{
+    AmbulanceQueue fleet;
+    for (int i = 0; i < units; i++)
+        fleet.addAmbulance("AMB" + to_string(i), "Driver " + to_string(i));
+
+    EventBus bus;
+    EmergencyDepartmentOfficer officer("Bench", "ED-BENCH");
+    officer.attachEventBus(&bus);
+    AutoDispatcher dispatcher(bus, fleet);
+
+    // Crew: holds assigned units, returns the oldest once half the fleet is out
+    int crewMailbox = bus.subscribe(EventBus::maskOf(EVENT_AMBULANCE_ASSIGNED));
+    long long doubleAssigned = 0;
+    thread crew([&]() {
+        unordered_set<string> out;
+        deque<string> oldestFirst;
+        HospitalEvent event;
+        while (bus.waitNext(crewMailbox, event))
+        {
+            if (!out.insert(event.ambulanceID).second)
+                doubleAssigned++;
+            oldestFirst.push_back(event.ambulanceID);
+            while ((int)oldestFirst.size() > units / 2)
+            {
+                out.erase(oldestFirst.front());
+                fleet.setStatus(oldestFirst.front(), STATUS_AVAILABLE);
+                oldestFirst.pop_front();
+            }
+        }
+    });
+
+    atomic<bool> stopTelemetry(false);
+    thread telemetry;
+    if (telemetryLoad)
+    {
+        telemetry = thread([&]() {
+            unsigned seed = 777u;
+            while (!stopTelemetry.load())
+            {
+                for (int i = 0; i < 64; i++)
+                {
+                    seed = seed * 1103515245u + 12345u;
+                    fleet.setPosition("AMB" + to_string((seed >> 8) % units), (seed >> 12) % 50000 / 1000.0,
+                                      (seed >> 4) % 50000 / 1000.0);
+                }
+                this_thread::yield();
+            }
+        });
+    }
+
+    const char* types[] = { "Cardiac Arrest", "Severe Trauma", "Stroke Symptoms", "Fracture" };
+    unsigned seed = 31337u;
+    long long cases = (long long)(casesPerSecond * seconds);
+    long long critical = 0;
+    steady_clock::time_point start = steady_clock::now();
+    for (long long i = 0; i < cases; i++)
+    {
+        // Paced against the schedule, yielding so the dispatcher can run
+        steady_clock::time_point due = start + duration_cast<steady_clock::duration>(duration<double>(i / casesPerSecond));
+        while (steady_clock::now() < due)
+            this_thread::yield();
+
+        seed = seed * 1103515245u + 12345u;
+        int priority = 1 + (int)((seed >> 8) % 10);
+        critical += priority >= officer.getDispatchThreshold();
+        officer.logCase(EmergencyCase(0, "Patient " + to_string(i), types[(seed >> 16) % 4], priority));
+    }
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+
+    dispatcher.stop(); // drains the cases still queued
+    bus.close(crewMailbox);
+    crew.join();
+    stopTelemetry = true;
+    if (telemetry.joinable())
+        telemetry.join();
+
+    RunResult r;
+    r.critical = critical;
+    r.assigned = dispatcher.getAssignedCount();
+    r.failed = dispatcher.getFailedCount();
+    r.doubleAssigned = doubleAssigned;
+    r.achievedRate = cases / elapsed;
+    r.latencyNs = dispatcher.latencySamples();
+    return r;
+}
+
+int main(int argc, char* argv[])
+{
+    int units = (argc > 1) ? atoi(argv[1]) : 2000;
+    double seconds = (argc > 2) ? atof(argv[2]) : 1.0;
+    if (units < 10)
+        units = 2000;
+    if (seconds <= 0)
+        seconds = 1.0;
+
+    cout << "Auto-dispatch latency, " << units << " units, threshold 8, "
+         << thread::hardware_concurrency() << " hardware thread(s)\n\n";
+    cout << left << setw(20) << "cases/s (target)" << right << setw(12) << "achieved" << setw(10) << "critical"
+         << setw(10) << "failed" << setw(10) << "p50 us" << setw(10) << "p99 us" << setw(11) << "p99.9 us"
+         << setw(10) << "max us" << endl;
+    cout << fixed << setprecision(1);
+
+    bool ok = true;
+    const double rates[] = { 1000, 10000, 50000, 100000 };
+    for (int row = 0; row < 5; row++)
+    {
+        bool withTelemetry = row == 4;
+        double rate = withTelemetry ? 50000 : rates[row];
+        RunResult r = run(units, rate, seconds, withTelemetry);
+        ok = ok && r.assigned + r.failed == r.critical && r.failed == 0 && r.doubleAssigned == 0 &&
+             (long long)r.latencyNs.size() == r.assigned;
+
+        string label = to_string((int)rate) + (withTelemetry ? " +telemetry" : "");
+        double maxUs = r.latencyNs.empty() ? 0 : *max_element(r.latencyNs.begin(), r.latencyNs.end()) / 1000.0;
+        cout << left << setw(20) << label << right << setw(12) << (long long)r.achievedRate << setw(10)
+             << r.critical << setw(10) << r.failed << setw(10) << percentileUs(r.latencyNs, 0.5) << setw(10)
+             << percentileUs(r.latencyNs, 0.99) << setw(11) << percentileUs(r.latencyNs, 0.999) << setw(10)
+             << maxUs << endl;
+    }
+    cout << "dispatch check: " << (ok ? "ok" : "FAILED") << endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// ============================================================================
+// BatchIntakeBench.cpp
+// One-at-a-time insertion vs insertBatch for a patient transfer
+// ----------------------------------------------------------------------------
+//   one-by-one   → insertEmergencyCase per case, O(n log n)
+//   batch-empty  → insertBatch into an empty heap (Floyd), O(n)
+//   batch-merge  → insertBatch into a heap already holding half the load
+// Each variant is checked by draining the heap in priority order, and so are
+// batches of 1-4 cases into an empty and a one-case heap (the rebuild edge).
+//
+// Build: g++ -std=gnu++14 -O2 bench/BatchIntakeBench.cpp -o batch_intake_bench
+// Usage: ./batch_intake_bench [cases=100000] [repeats=5]
+// ============================================================================
+
+#include "../EmergencyDepartment.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static vector<EmergencyCase> makeCases(int count, int firstID) {
+    vector<EmergencyCase> cases;
+    cases.reserve(count);
+    unsigned seed = 2024u + firstID;
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int priority = 1 + (int)((seed >> 16) % 10);
+        cases.push_back(EmergencyCase(firstID + i, "Transfer " + to_string(i),
+                                      "Trauma", priority));
+    }
+    return cases;
+}
+
+static bool drainsInOrder(EmergencyPriorityQueue& queue) {
+    int previous = 11;
+    while (!queue.isEmpty()) {
+        int priority = queue.extractMostCritical().priorityLevel;
+        if (priority > previous) return false;
+        previous = priority;
+    }
+    return true;
+}
+
+static double bestOf(int repeats, double (*run)(const vector<EmergencyCase>&, const vector<EmergencyCase>&, bool&),
+                     const vector<EmergencyCase>& seedCases, const vector<EmergencyCase>& cases, bool& ok) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        double ms = run(seedCases, cases, ok);
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+static double runOneByOne(const vector<EmergencyCase>& seedCases, const vector<EmergencyCase>& cases, bool& ok) {
+    EmergencyPriorityQueue queue(20);
+    for (size_t i = 0; i < seedCases.size(); i++) queue.insertEmergencyCase(seedCases[i]);
+    steady_clock::time_point t0 = steady_clock::now();
+    for (size_t i = 0; i < cases.size(); i++) queue.insertEmergencyCase(cases[i]);
+    double ms = duration<double, milli>(steady_clock::now() - t0).count();
+    ok = ok && drainsInOrder(queue);
+    return ms;
+}
+
+static double runBatch(const vector<EmergencyCase>& seedCases, const vector<EmergencyCase>& cases, bool& ok) {
+    EmergencyPriorityQueue queue(20);
+    queue.insertBatch(seedCases.begin(), seedCases.end());
+    steady_clock::time_point t0 = steady_clock::now();
+    queue.insertBatch(cases.begin(), cases.end());
+    double ms = duration<double, milli>(steady_clock::now() - t0).count();
+    ok = ok && drainsInOrder(queue);
+    return ms;
+}
+
+// Tiny transfers, e.g. a one-line file while the queue is empty
+static bool smallBatchesOk() {
+    bool ok = true;
+    for (int existing = 0; existing <= 1; existing++) {
+        for (int count = 1; count <= 4; count++) {
+            EmergencyPriorityQueue queue(20);
+            vector<EmergencyCase> resident = makeCases(existing, 100);
+            vector<EmergencyCase> cases = makeCases(count, 1);
+            queue.insertBatch(resident.begin(), resident.end());
+            queue.insertBatch(cases.begin(), cases.end());
+            ok = ok && queue.getSize() == existing + count && drainsInOrder(queue);
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    int count = (argc > 1) ? atoi(argv[1]) : 100000;
+    int repeats = (argc > 2) ? atoi(argv[2]) : 5;
+    if (count <= 0) count = 100000;
+    if (repeats <= 0) repeats = 5;
+
+    vector<EmergencyCase> none;
+    vector<EmergencyCase> transfer = makeCases(count, 1);
+    vector<EmergencyCase> resident = makeCases(count / 2, count + 1);
+    bool ok = smallBatchesOk();
+
+    double oneByOne = bestOf(repeats, runOneByOne, none, transfer, ok);
+    double batchEmpty = bestOf(repeats, runBatch, none, transfer, ok);
+    double oneByOneMerge = bestOf(repeats, runOneByOne, resident, transfer, ok);
+    double batchMerge = bestOf(repeats, runBatch, resident, transfer, ok);
+
+    cout << "Batch intake of " << count << " cases (best of " << repeats << ", ms)\n";
+    cout << left << setw(22) << "variant" << right << setw(12) << "ms" << setw(12) << "speedup" << endl;
+    cout << fixed << setprecision(2);
+    cout << left << setw(22) << "one-by-one (empty)" << right << setw(12) << oneByOne << setw(12) << 1.0 << endl;
+    cout << left << setw(22) << "batch-empty" << right << setw(12) << batchEmpty << setw(12) << oneByOne / batchEmpty << endl;
+    cout << left << setw(22) << "one-by-one (+n/2)" << right << setw(12) << oneByOneMerge << setw(12) << 1.0 << endl;
+    cout << left << setw(22) << "batch-merge (+n/2)" << right << setw(12) << batchMerge << setw(12) << oneByOneMerge / batchMerge << endl;
+    cout << "heap order check: " << (ok ? "ok" : "FAILED") << endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+// ============================================================================
+// BayAllocatorBench.cpp
+// Bay allocation throughput: BayAllocator vs a linear-scan allocator
+// ----------------------------------------------------------------------------
+// Floor plan: 10% resus, 20% trauma, 70% general bays. Every bay is filled
+// and a backlog of a quarter of the bay count is left waiting. Then each
+// step discharges a random occupied case (the freed bay is matched to the
+// best compatible waiting case) and a new arrival requests a bay.
+//
+//   allocator   → BayAllocator: per-capability free sets + waitlist heaps
+//   linear-scan → scan all bays for a free one, scan one waiting list for
+//                 the highest-priority compatible case
+// Every assignment is checked for bay compatibility, and both allocators
+// must make the same number of assignments.
+//
+// Build: g++ -std=gnu++14 -O2 bench/BayAllocatorBench.cpp -o bay_allocator_bench
+// Usage: ./bay_allocator_bench [steps=200000]
+// ============================================================================
+
+#include "../EmergencyDepartment.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static const char* TYPES[] = { "Cardiac", "Head Trauma", "Fracture", "Fever", "Abdominal Pain",
+                               "Burns", "Asthma", "Migraine", "Laceration Wound", "Flu" };
+
+static vector<EmergencyCase> makeArrivals(int count) {
+    vector<EmergencyCase> cases(count);
+    unsigned seed = 77u;
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int roll = (int)((seed >> 16) % 100);
+        cases[i].caseID = i + 1;
+        cases[i].priorityLevel = roll < 15 ? 8 + roll % 3 : (roll < 50 ? 5 + roll % 3 : 1 + roll % 4);
+        cases[i].emergencyType = TYPES[(seed >> 8) % 10];
+    }
+    return cases;
+}
+
+static BayCapability floorPlan(int bayIndex, int bayCount) {
+    if (bayIndex < bayCount / 10) return BAY_RESUS;
+    if (bayIndex < bayCount * 3 / 10) return BAY_TRAUMA;
+    return BAY_GENERAL;
+}
+
+// Reference allocator: everything is a linear scan
+class LinearScanAllocator {
+private:
+    vector<BayCapability> capability;
+    vector<int> occupant;
+    vector<EmergencyCase> waiting;
+
+public:
+    explicit LinearScanAllocator(int bayCount) {
+        for (int i = 0; i < bayCount; i++) {
+            capability.push_back(floorPlan(i, bayCount));
+            occupant.push_back(-1);
+        }
+    }
+
+    BayCapability capabilityOf(int bayID) const {
+        return capability[bayID];
+    }
+
+    int request(const EmergencyCase& c) {
+        BayCapability need = BayAllocator::requiredCapability(c);
+        int best = -1;
+        for (int i = 0; i < (int)occupant.size(); i++) {
+            if (occupant[i] == -1 && capability[i] >= need &&
+                (best == -1 || capability[i] < capability[best])) {
+                best = i;
+            }
+        }
+        if (best == -1) {
+            waiting.push_back(c);
+        } else {
+            occupant[best] = c.caseID;
+        }
+        return best;
+    }
+
+    int release(int caseID, EmergencyCase& matched) {
+        int bayID = -1;
+        for (int i = 0; i < (int)occupant.size() && bayID == -1; i++) {
+            if (occupant[i] == caseID) bayID = i;
+        }
+        if (bayID == -1) return -1;
+        occupant[bayID] = -1;
+
+        int best = -1;
+        for (int i = 0; i < (int)waiting.size(); i++) {
+            if (BayAllocator::requiredCapability(waiting[i]) <= capability[bayID] &&
+                (best == -1 || waiting[i].priorityLevel > waiting[best].priorityLevel)) {
+                best = i;
+            }
+        }
+        if (best == -1) return -1;
+        matched = waiting[best];
+        waiting.erase(waiting.begin() + best);
+        occupant[bayID] = matched.caseID;
+        return bayID;
+    }
+};
+
+struct RunResult {
+    double opsPerSecond;
+    long long assignments;
+    bool compatible;
+};
+
+template <typename Allocator, typename CapabilityOf>
+static RunResult run(Allocator& allocator, CapabilityOf capabilityOf, int bayCount,
+                     const vector<EmergencyCase>& arrivals, int steps) {
+    RunResult result = { 0, 0, true };
+    vector<int> occupied;          // caseIDs currently holding a bay
+    size_t next = 0;
+    unsigned seed = 99u;
+
+    auto admit = [&](const EmergencyCase& c, int bayID) {
+        if (bayID == -1) return;
+        result.assignments++;
+        result.compatible = result.compatible && capabilityOf(bayID) >= BayAllocator::requiredCapability(c);
+        occupied.push_back(c.caseID);
+    };
+
+    while ((int)occupied.size() < bayCount || next < (size_t)(bayCount + bayCount / 4)) {
+        const EmergencyCase& c = arrivals[next++];
+        admit(c, allocator.request(c));
+    }
+
+    steady_clock::time_point t0 = steady_clock::now();
+    for (int step = 0; step < steps && next < arrivals.size(); step++) {
+        seed = seed * 1103515245u + 12345u;
+        size_t pick = (seed >> 8) % occupied.size();
+        int caseID = occupied[pick];
+        occupied[pick] = occupied.back();
+        occupied.pop_back();
+
+        EmergencyCase matched;
+        admit(matched, allocator.release(caseID, matched));
+
+        const EmergencyCase& c = arrivals[next++];
+        admit(c, allocator.request(c));
+    }
+    double seconds = duration<double>(steady_clock::now() - t0).count();
+    result.opsPerSecond = 2.0 * steps / seconds;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    int steps = (argc > 1) ? atoi(argv[1]) : 200000;
+    if (steps <= 0) steps = 200000;
+
+    const int bayCounts[] = { 100, 200, 400, 800 };
+    vector<EmergencyCase> arrivals = makeArrivals(steps + 2000);
+    bool ok = true;
+
+    cout << "Bay allocation, " << steps << " discharge+arrival steps (ops/s)\n";
+    cout << left << setw(8) << "bays" << right << setw(16) << "allocator" << setw(16) << "linear-scan"
+         << setw(12) << "speedup" << endl;
+    cout << fixed << setprecision(0);
+
+    for (size_t b = 0; b < sizeof(bayCounts) / sizeof(bayCounts[0]); b++) {
+        int bayCount = bayCounts[b];
+
+        BayAllocator allocator;
+        for (int i = 0; i < bayCount; i++) allocator.addBay(floorPlan(i, bayCount));
+        RunResult fast = run(allocator,
+                             [&allocator](int bayID) { return allocator.getBay(bayID).capability; },
+                             bayCount, arrivals, steps);
+
+        LinearScanAllocator scan(bayCount);
+        RunResult slow = run(scan, [&scan](int bayID) { return scan.capabilityOf(bayID); },
+                             bayCount, arrivals, steps);
+
+        ok = ok && fast.compatible && slow.compatible && fast.assignments == slow.assignments;
+        cout << left << setw(8) << bayCount << right << setw(16) << fast.opsPerSecond
+             << setw(16) << slow.opsPerSecond << setw(11) << setprecision(1)
+             << fast.opsPerSecond / slow.opsPerSecond << "x" << setprecision(0) << endl;
+    }
+    cout << "compatibility check: " << (ok ? "ok" : "FAILED") << endl;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,337 @@
+// ============================================================================
+// BenchSuite.cpp
+// Microbenchmarks for the core structure of every role, sizes 10 .. 10^6
+// ----------------------------------------------------------------------------
+//   PatientQueue           admit, discharge, search (find by ID, O(n) walk)
+//   MedicalSupply          push (addStock), pop (useLast), purge (scan for
+//                          expired batches; addStock refuses past dates, so
+//                          every batch is checked and none is removed)
+//   EmergencyPriorityQueue insert, extract, display-sort (the sorted copy
+//                          behind "View All Pending Cases")
+//   AmbulanceQueue         rotate, search (getUnit), update (setStatus)
+//
+// Each row is one (structure, operation, size): the operation is repeated
+// on a structure holding `size` elements, fixed seeds, no console output.
+// ns_per_op is the median over the repetitions, min_ns_per_op the best.
+// Output is CSV (default) or JSON on stdout, same row order every run, so
+// two versions can be diffed or loaded side by side.
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/BenchSuite.cpp PatientAdmission.cpp MedicalSupply.cpp Ambulance.cpp -o bench_suite
+// Usage: ./bench_suite [--format=csv|json] [--max=1000000] [--filter=text]
+// ============================================================================
+
+#include "../PatientAdmission.hpp"
+#include "../MedicalSupply.hpp"
+#include "../EmergencyDepartment.hpp"
+#include "../Ambulance.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static volatile long long sink; // keeps results observable
+
+// Started/stopped by each benchmark around the measured part only
+class Stopwatch {
+private:
+    steady_clock::time_point started;
+    double elapsedNs;
+
+public:
+    Stopwatch() : elapsedNs(0) {}
+    void start() { started = steady_clock::now(); }
+    void stop() { elapsedNs += duration<double, nano>(steady_clock::now() - started).count(); }
+    double ns() const { return elapsedNs; }
+};
+
+// One repetition at size n; returns how many operations were timed
+typedef function<long long(long n, Stopwatch& timer)> Benchmark;
+
+struct Row {
+    string structure;
+    string operation;
+    long size;
+    long long ops;
+    double medianNs;
+    double minNs;
+};
+
+static unsigned seed = 20240601u;
+
+static unsigned nextRandom() {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+// Bound the work of O(n) operations so the biggest sizes stay in seconds
+static long long boundedOps(long n, long long budget) {
+    return max(1LL, min((long long)n, budget / max(1L, n)));
+}
+
+static string patientID(long i) {
+    string digits = to_string(i + 1);
+    return "P" + string(digits.size() < 3 ? 3 - digits.size() : 0, '0') + digits;
+}
+
+// ---------------------------------------------------------------- patients
+static void fillPatients(PatientQueue& queue, long n) {
+    const char* conditions[] = { "Normal", "Critical", "Emergency" };
+    for (long i = 0; i < n; i++) {
+        PatientRecord p("Patient " + to_string(i), conditions[i % 3]);
+        queue.admit(p);
+    }
+}
+
+static long long patientAdmit(long n, Stopwatch& timer) {
+    PatientQueue queue;
+    vector<PatientRecord> records;
+    records.reserve(n);
+    for (long i = 0; i < n; i++) records.push_back(PatientRecord("Patient " + to_string(i), "Normal"));
+    timer.start();
+    for (long i = 0; i < n; i++) queue.admit(records[i]);
+    timer.stop();
+    sink = sink + queue.count();
+    return n;
+}
+
+static long long patientDischarge(long n, Stopwatch& timer) {
+    PatientQueue queue;
+    fillPatients(queue, n);
+    PatientRecord out;
+    timer.start();
+    for (long i = 0; i < n; i++) queue.discharge(out);
+    timer.stop();
+    sink = sink + out.name.size();
+    return n;
+}
+
+static long long patientSearch(long n, Stopwatch& timer) {
+    PatientQueue queue;
+    fillPatients(queue, n);
+    long long ops = boundedOps(n, 20000000);
+    vector<string> ids;
+    for (long long i = 0; i < ops; i++) ids.push_back(patientID((long)(nextRandom() % n)));
+    PatientRecord found;
+    long long hits = 0;
+    timer.start();
+    for (long long i = 0; i < ops; i++) hits += queue.find(ids[i], found) == OP_OK;
+    timer.stop();
+    sink = sink + hits;
+    return ops;
+}
+
+// ---------------------------------------------------------------- supplies
+static void fillSupplies(MedicalSupply& stock, long n) {
+    const char* types[] = { "Mask", "Gloves", "Syringe", "Gauze" };
+    for (long i = 0; i < n; i++) stock.addStock(types[i % 4], 10, "2030-06-30", "");
+}
+
+static long long supplyPush(long n, Stopwatch& timer) {
+    MedicalSupply stock;
+    timer.start();
+    fillSupplies(stock, n);
+    timer.stop();
+    sink = sink + stock.getItemCount();
+    return n;
+}
+
+static long long supplyPop(long n, Stopwatch& timer) {
+    MedicalSupply stock;
+    fillSupplies(stock, n);
+    timer.start();
+    for (long i = 0; i < n; i++) stock.useLast(10);
+    timer.stop();
+    sink = sink + stock.getItemCount();
+    return n;
+}
+
+static long long supplyPurge(long n, Stopwatch& timer) {
+    MedicalSupply stock;
+    fillSupplies(stock, n);
+    timer.start();
+    int removed = stock.purgeExpired();
+    timer.stop();
+    sink = sink + removed + stock.getItemCount();
+    return n; // per batch checked
+}
+
+// ---------------------------------------------------------------- ED heap
+static vector<EmergencyCase> makeCases(long n) {
+    vector<EmergencyCase> cases;
+    cases.reserve(n);
+    EmergencyCase prototype(0, "Patient", "Walk-in", 1);
+    for (long i = 0; i < n; i++) {
+        EmergencyCase c = prototype;
+        c.caseID = (int)i;
+        c.priorityLevel = 1 + (int)(nextRandom() % 10);
+        cases.push_back(c);
+    }
+    return cases;
+}
+
+static long long caseInsert(long n, Stopwatch& timer) {
+    vector<EmergencyCase> cases = makeCases(n);
+    EmergencyPriorityQueue queue(20);
+    timer.start();
+    for (long i = 0; i < n; i++) queue.insertEmergencyCase(cases[i]);
+    timer.stop();
+    sink = sink + queue.getSize();
+    return n;
+}
+
+static long long caseExtract(long n, Stopwatch& timer) {
+    vector<EmergencyCase> cases = makeCases(n);
+    EmergencyPriorityQueue queue(20);
+    for (long i = 0; i < n; i++) queue.insertEmergencyCase(cases[i]);
+    long long total = 0;
+    timer.start();
+    for (long i = 0; i < n; i++) total += queue.extractMostCritical().priorityLevel;
+    timer.stop();
+    sink = sink + total;
+    return n;
+}
+
+static long long caseDisplaySort(long n, Stopwatch& timer) {
+    vector<EmergencyCase> cases = makeCases(n);
+    EmergencyPriorityQueue queue(20);
+    for (long i = 0; i < n; i++) queue.insertEmergencyCase(cases[i]);
+    timer.start();
+    vector<EmergencyCase> sorted = queue.casesInPriorityOrder();
+    timer.stop();
+    sink = sink + sorted.front().caseID;
+    return n; // per case listed
+}
+
+// ---------------------------------------------------------------- ambulances
+static void fillFleet(AmbulanceQueue& fleet, long n) {
+    for (long i = 0; i < n; i++) fleet.addAmbulance("AMB" + to_string(i), "Driver");
+}
+
+static long long ambulanceRotate(long n, Stopwatch& timer) {
+    AmbulanceQueue fleet;
+    fillFleet(fleet, n);
+    long long ops = max(n, 100000L);
+    string front;
+    timer.start();
+    for (long long i = 0; i < ops; i++) fleet.rotateOnce(front);
+    timer.stop();
+    sink = sink + front.size();
+    return ops;
+}
+
+static long long ambulanceSearch(long n, Stopwatch& timer) {
+    AmbulanceQueue fleet;
+    fillFleet(fleet, n);
+    long long ops = 100000;
+    vector<string> ids;
+    for (long long i = 0; i < ops; i++) ids.push_back("AMB" + to_string(nextRandom() % n));
+    Ambulance unit;
+    long long hits = 0;
+    timer.start();
+    for (long long i = 0; i < ops; i++) hits += fleet.getUnit(ids[i], unit) == OP_OK;
+    timer.stop();
+    sink = sink + hits;
+    return ops;
+}
+
+static long long ambulanceUpdate(long n, Stopwatch& timer) {
+    AmbulanceQueue fleet;
+    fillFleet(fleet, n);
+    long long ops = 100000;
+    vector<string> ids;
+    for (long long i = 0; i < ops; i++) ids.push_back("AMB" + to_string(nextRandom() % n));
+    timer.start();
+    for (long long i = 0; i < ops; i++) {
+        fleet.setStatus(ids[i], (i & 1) ? STATUS_AVAILABLE : STATUS_ON_DUTY);
+    }
+    timer.stop();
+    sink = sink + fleet.countByStatus(STATUS_ON_DUTY);
+    return ops;
+}
+
+// ---------------------------------------------------------------- driver
+static Row measure(const char* structure, const char* operation, long n, Benchmark bench) {
+    int reps = n >= 100000 ? 3 : (n >= 10000 ? 5 : 9);
+    vector<double> nsPerOp;
+    long long ops = 0;
+    for (int r = 0; r < reps; r++) {
+        Stopwatch timer;
+        ops = bench(n, timer);
+        nsPerOp.push_back(timer.ns() / ops);
+    }
+    sort(nsPerOp.begin(), nsPerOp.end());
+    Row row = { structure, operation, n, ops, nsPerOp[nsPerOp.size() / 2], nsPerOp.front() };
+    return row;
+}
+
+int main(int argc, char* argv[]) {
+    string format = "csv";
+    long maxSize = 1000000;
+    string filter;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--format=", 9) == 0) format = argv[i] + 9;
+        else if (strncmp(argv[i], "--max=", 6) == 0) maxSize = atol(argv[i] + 6);
+        else if (strncmp(argv[i], "--filter=", 9) == 0) filter = argv[i] + 9;
+        else {
+            cerr << "Usage: " << argv[0] << " [--format=csv|json] [--max=1000000] [--filter=text]\n";
+            return 2;
+        }
+    }
+    if (format != "csv" && format != "json") {
+        cerr << "Unknown format: " << format << endl;
+        return 2;
+    }
+
+    struct Case {
+        const char* structure;
+        const char* operation;
+        Benchmark bench;
+    };
+    const Case cases[] = {
+        { "PatientQueue", "admit", patientAdmit },
+        { "PatientQueue", "discharge", patientDischarge },
+        { "PatientQueue", "search", patientSearch },
+        { "MedicalSupply", "push", supplyPush },
+        { "MedicalSupply", "pop", supplyPop },
+        { "MedicalSupply", "purge", supplyPurge },
+        { "EmergencyPriorityQueue", "insert", caseInsert },
+        { "EmergencyPriorityQueue", "extract", caseExtract },
+        { "EmergencyPriorityQueue", "display-sort", caseDisplaySort },
+        { "AmbulanceQueue", "rotate", ambulanceRotate },
+        { "AmbulanceQueue", "search", ambulanceSearch },
+        { "AmbulanceQueue", "update", ambulanceUpdate },
+    };
+
+    bool json = format == "json";
+    cout << fixed << setprecision(1);
+    if (json) cout << "{\"suite\":\"hospital-core\",\"unit\":\"ns_per_op\",\"results\":[";
+    else cout << "structure,operation,size,ops,ns_per_op,min_ns_per_op\n";
+
+    bool first = true;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        string name = string(cases[c].structure) + "." + cases[c].operation;
+        if (!filter.empty() && name.find(filter) == string::npos) continue;
+        for (long n = 10; n <= maxSize; n *= 10) {
+            seed = 20240601u; // same inputs for every version
+            Row r = measure(cases[c].structure, cases[c].operation, n, cases[c].bench);
+            if (json) {
+                cout << (first ? "" : ",") << "\n  {\"structure\":\"" << r.structure << "\",\"operation\":\""
+                     << r.operation << "\",\"size\":" << r.size << ",\"ops\":" << r.ops
+                     << ",\"ns_per_op\":" << r.medianNs << ",\"min_ns_per_op\":" << r.minNs << "}";
+            } else {
+                cout << r.structure << "," << r.operation << "," << r.size << "," << r.ops << ","
+                     << r.medianNs << "," << r.minNs << "\n";
+            }
+            cout.flush();
+            first = false;
+        }
+    }
+    if (json) cout << "\n]}\n";
+    return 0;
+}
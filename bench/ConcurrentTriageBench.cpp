@@ -0,0 +1,236 @@
+// ============================================================================
+// ConcurrentTriageBench.cpp
+// Stress check and thread scaling for ConcurrentTriageQueue
+// ----------------------------------------------------------------------------
+// 1) Stress: every thread logs and extracts cases concurrently. Each
+//    operation is stamped from one shared atomic clock, then the history is
+//    checked for:
+//      - every logged case extracted exactly once
+//      - strict critical lane: no extraction returned a lower-priority case
+//        while a critical case that had finished logging before the
+//        extraction started was still waiting when it ended
+// 2) Scaling: mixed 50/50 log/extract throughput for 1-32 threads, against
+//    a single EmergencyPriorityQueue behind one global mutex.
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/ConcurrentTriageBench.cpp -o concurrent_triage_bench
+// Usage: ./concurrent_triage_bench [opsPerThread=200000]
+// ============================================================================
+
+#include "../ConcurrentTriageQueue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static atomic<long long> logicalClock(0);
+
+struct LoggedOp {
+    int caseID;
+    int priority;
+    long long start;
+    long long end;
+};
+
+static int priorityFor(unsigned& seed) {
+    seed = seed * 1103515245u + 12345u;
+    return 1 + (int)((seed >> 16) % 10);
+}
+
+// ---------------------------------------------------------------------------
+// Stress / history check
+// ---------------------------------------------------------------------------
+static bool runStress(int threads, int opsPerThread) {
+    ConcurrentTriageQueue queue(threads);
+    vector<vector<LoggedOp> > inserts(threads), extracts(threads);
+
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&, t]() {
+            unsigned seed = 977u * (t + 1);
+            for (int i = 0; i < opsPerThread; i++) {
+                // Two logs per extraction so a backlog builds up
+                if (i % 3 != 2) {
+                    LoggedOp op;
+                    op.caseID = t * opsPerThread + i;
+                    op.priority = priorityFor(seed);
+                    op.start = logicalClock.fetch_add(1);
+                    queue.insert(EmergencyCase(op.caseID, "P", "T", op.priority));
+                    op.end = logicalClock.fetch_add(1);
+                    inserts[t].push_back(op);
+                } else {
+                    EmergencyCase c;
+                    LoggedOp op;
+                    op.start = logicalClock.fetch_add(1);
+                    bool got = queue.tryExtract(c);
+                    op.end = logicalClock.fetch_add(1);
+                    if (got) {
+                        op.caseID = c.caseID;
+                        op.priority = c.priorityLevel;
+                        extracts[t].push_back(op);
+                    }
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+
+    // Drain what is left, single threaded
+    vector<LoggedOp> allExtracts;
+    for (int t = 0; t < threads; t++) allExtracts.insert(allExtracts.end(), extracts[t].begin(), extracts[t].end());
+    EmergencyCase c;
+    for (;;) {
+        LoggedOp op;
+        op.start = logicalClock.fetch_add(1);
+        if (!queue.tryExtract(c)) break;
+        op.end = logicalClock.fetch_add(1);
+        op.caseID = c.caseID;
+        op.priority = c.priorityLevel;
+        allExtracts.push_back(op);
+    }
+
+    vector<LoggedOp> allInserts;
+    for (int t = 0; t < threads; t++) allInserts.insert(allInserts.end(), inserts[t].begin(), inserts[t].end());
+
+    // Exactly-once
+    vector<long long> extractStartByCase(threads * (size_t)opsPerThread, -1);
+    bool ok = true;
+    for (size_t i = 0; i < allExtracts.size(); i++) {
+        long long& slot = extractStartByCase[allExtracts[i].caseID];
+        if (slot != -1) {
+            cout << "  duplicate extraction of case " << allExtracts[i].caseID << endl;
+            ok = false;
+        }
+        slot = allExtracts[i].start;
+    }
+    if (allExtracts.size() != allInserts.size()) {
+        cout << "  logged " << allInserts.size() << " but extracted " << allExtracts.size() << endl;
+        ok = false;
+    }
+
+    // Strict critical lane: for each extracted priority p, no case of a
+    // higher critical priority q may have been logged before the extraction
+    // began and still be waiting when it finished.
+    int threshold = queue.getCriticalThreshold();
+    long long violations = 0;
+    for (int q = threshold; q <= PriorityHistogram::MAX_PRIORITY; q++) {
+        vector<pair<long long, long long> > waiting;   // (logged end, extract start)
+        for (size_t i = 0; i < allInserts.size(); i++) {
+            if (allInserts[i].priority == q) {
+                waiting.push_back(make_pair(allInserts[i].end, extractStartByCase[allInserts[i].caseID]));
+            }
+        }
+        sort(waiting.begin(), waiting.end());
+
+        vector<LoggedOp> lower;
+        for (size_t i = 0; i < allExtracts.size(); i++) {
+            if (allExtracts[i].priority < q) lower.push_back(allExtracts[i]);
+        }
+        sort(lower.begin(), lower.end(), [](const LoggedOp& a, const LoggedOp& b) { return a.start < b.start; });
+
+        size_t w = 0;
+        long long latestPickup = -1;
+        for (size_t i = 0; i < lower.size(); i++) {
+            while (w < waiting.size() && waiting[w].first < lower[i].start) {
+                latestPickup = max(latestPickup, waiting[w].second);
+                w++;
+            }
+            if (latestPickup > lower[i].end) violations++;
+        }
+    }
+    if (violations > 0) {
+        cout << "  " << violations << " strict-priority violation(s)" << endl;
+        ok = false;
+    }
+
+    cout << "stress threads=" << threads << " logged=" << allInserts.size()
+         << " extracted=" << allExtracts.size() << " : " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Scaling
+// ---------------------------------------------------------------------------
+class GlobalLockQueue {
+private:
+    mutex lock;
+    EmergencyPriorityQueue heap;
+
+public:
+    GlobalLockQueue() : heap(64) {}
+
+    void insert(EmergencyCase c) {
+        lock_guard<mutex> guard(lock);
+        heap.insertEmergencyCase(std::move(c));
+    }
+
+    bool tryExtract(EmergencyCase& out) {
+        lock_guard<mutex> guard(lock);
+        if (heap.isEmpty()) return false;
+        out = heap.extractMostCritical();
+        return true;
+    }
+};
+
+template <typename Queue>
+static double measureThroughput(Queue& queue, int threads, int opsPerThread) {
+    // Pre-load so extracts rarely find the pool empty
+    unsigned seed = 1;
+    for (int i = 0; i < 10000; i++) {
+        queue.insert(EmergencyCase(-1 - i, "P", "T", priorityFor(seed)));
+    }
+
+    atomic<bool> go(false);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&, t]() {
+            unsigned localSeed = 31u * (t + 1);
+            EmergencyCase c;
+            while (!go.load()) this_thread::yield();
+            for (int i = 0; i < opsPerThread; i++) {
+                if (i % 2 == 0) {
+                    queue.insert(EmergencyCase(t * opsPerThread + i, "P", "T", priorityFor(localSeed)));
+                } else {
+                    queue.tryExtract(c);
+                }
+            }
+        }));
+    }
+    steady_clock::time_point t0 = steady_clock::now();
+    go.store(true);
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+    double seconds = duration<double>(steady_clock::now() - t0).count();
+    return (double)threads * opsPerThread / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    int opsPerThread = (argc > 1) ? atoi(argv[1]) : 200000;
+    if (opsPerThread <= 0) opsPerThread = 200000;
+
+    bool ok = true;
+    int stressThreads[] = {2, 4, 8};
+    for (int i = 0; i < 3; i++) {
+        ok = runStress(stressThreads[i], opsPerThread / 4) && ok;
+    }
+
+    cout << "\nhardware threads: " << thread::hardware_concurrency() << "\n";
+    cout << left << setw(10) << "threads" << right << setw(18) << "global_lock_ops/s"
+         << setw(18) << "multiqueue_ops/s" << endl;
+    int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    for (int i = 0; i < 6; i++) {
+        int threads = threadCounts[i];
+        int perThread = opsPerThread / threads;
+        if (perThread < 1000) perThread = 1000;
+        GlobalLockQueue baseline;
+        ConcurrentTriageQueue multi(threads);
+        double baseOps = measureThroughput(baseline, threads, perThread);
+        double multiOps = measureThroughput(multi, threads, perThread);
+        cout << left << setw(10) << threads << right << fixed << setprecision(0)
+             << setw(18) << baseOps << setw(18) << multiOps << endl;
+    }
+
+    return ok ? 0 : 1;
+}
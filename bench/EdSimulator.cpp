@@ -0,0 +1,326 @@
+// ============================================================================
+// EdSimulator.cpp
+// Headless discrete-event simulation of the ED engine for capacity planning
+// ----------------------------------------------------------------------------
+// Drives EmergencyPriorityQueue, TreatmentBoard and SlaTimingWheel exactly as
+// the officer menu does (insert + SLA on arrival, extract + admit + cancel
+// when a bay frees, complete when treatment ends), without any console I/O.
+//
+//   arrivals  → Poisson at rate/hour; every surge-every hours the rate is
+//               multiplied by surge-factor for surge-length hours (thinning)
+//   triage    → priority 1-10 drawn from the mix weights
+//   treatment → per-class mean minutes (standard,urgent,critical), drawn from
+//               an exponential, lognormal (CV 1) or fixed distribution
+//   bays      → number of cases that can be in treatment at once
+//
+// Reports queue length (time-weighted mean, hourly p50/p95, max), wait time
+// percentiles and SLA breaches per priority, and events/s + engine ops/s.
+// The run fails if any case is lost (arrived != treated + in bay + queued).
+//
+// The default run is ~20M events (~1 simulated year); it doubles as the
+// regression benchmark for the ED engine.
+//
+// Build: g++ -std=gnu++14 -O2 bench/EdSimulator.cpp -o ed_simulator
+// Usage: ./ed_simulator [days=365] [rate=1000] [bays=820] [seed=1]
+//                       [surge-every=24] [surge-length=2] [surge-factor=3]
+//                       [mix=15,15,12,12,10,10,8,7,6,5] [treat=20,45,90]
+//                       [service=lognormal|exp|fixed]
+// ============================================================================
+
+#include "../EmergencyDepartment.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+struct SimConfig {
+    double days;
+    double ratePerHour;
+    int bays;
+    unsigned long long seed;
+    double surgeEveryHours;
+    double surgeLengthHours;
+    double surgeFactor;
+    vector<double> mix;            // weights for priority 1-10
+    double treatMinutes[3];        // standard, urgent, critical
+    string service;
+
+    SimConfig() : days(365), ratePerHour(1000), bays(820), seed(1),
+                  surgeEveryHours(24), surgeLengthHours(2), surgeFactor(3),
+                  mix({ 15, 15, 12, 12, 10, 10, 8, 7, 6, 5 }), service("lognormal") {
+        treatMinutes[0] = 20;
+        treatMinutes[1] = 45;
+        treatMinutes[2] = 90;
+    }
+};
+
+static vector<double> parseList(const string& text) {
+    vector<double> values;
+    stringstream in(text);
+    string item;
+    while (getline(in, item, ',')) {
+        values.push_back(atof(item.c_str()));
+    }
+    return values;
+}
+
+static bool parseArgs(int argc, char* argv[], SimConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        size_t eq = arg.find('=');
+        if (eq == string::npos) return false;
+        string key = arg.substr(0, eq);
+        string value = arg.substr(eq + 1);
+
+        if (key == "days") config.days = atof(value.c_str());
+        else if (key == "rate") config.ratePerHour = atof(value.c_str());
+        else if (key == "bays") config.bays = atoi(value.c_str());
+        else if (key == "seed") config.seed = strtoull(value.c_str(), nullptr, 10);
+        else if (key == "surge-every") config.surgeEveryHours = atof(value.c_str());
+        else if (key == "surge-length") config.surgeLengthHours = atof(value.c_str());
+        else if (key == "surge-factor") config.surgeFactor = atof(value.c_str());
+        else if (key == "mix") config.mix = parseList(value);
+        else if (key == "treat") {
+            vector<double> means = parseList(value);
+            if (means.size() != 3) return false;
+            for (int c = 0; c < 3; c++) config.treatMinutes[c] = means[c];
+        }
+        else if (key == "service") config.service = value;
+        else return false;
+    }
+    return config.days > 0 && config.ratePerHour > 0 && config.bays > 0 &&
+           config.surgeFactor >= 1 && config.mix.size() == 10 &&
+           (config.service == "lognormal" || config.service == "exp" || config.service == "fixed");
+}
+
+// ---------------------------------------------------------------------------
+// Event list: min-heap on simulated time, built from the same template
+// ---------------------------------------------------------------------------
+enum SimEventType { EVENT_ARRIVAL, EVENT_TREATMENT_DONE, EVENT_HOURLY_SAMPLE };
+
+struct SimEvent {
+    double minute;
+    SimEventType type;
+    TreatmentHandle handle;        // EVENT_TREATMENT_DONE only
+};
+
+struct SimEventTimeKey {
+    double operator()(const SimEvent& e) const {
+        return e.minute;
+    }
+};
+
+typedef PriorityQueue<SimEvent, SimEventTimeKey, greater<double>, 4> SimEventQueue;
+
+static int priorityClass(int priority) {
+    if (priority >= 8) return 2;    // Critical
+    if (priority >= 5) return 1;    // Urgent
+    return 0;                       // Standard
+}
+
+static int slaSeconds(int priority) {
+    static const int minutes[3] = { 120, 30, 10 };
+    return minutes[priorityClass(priority)] * 60;
+}
+
+// Deadlines on a 64^k boundary reach level 0 through a cascade in the very
+// second they are due; they must be reported then, not one second later
+static bool slaBoundaryOk() {
+    static const time_t deadlines[3] = { 2 * 64, 64 * 64, 2 * 64 * 64 + 64 };
+    for (int i = 0; i < 3; i++) {
+        SlaTimingWheel wheel(0);
+        vector<SlaTimingWheel::Breach> breaches;
+        wheel.schedule(1, 9, deadlines[i]);
+        if (wheel.advance(deadlines[i] - 1, breaches) != 0) return false;
+        if (wheel.advance(deadlines[i], breaches) != 1) return false;
+        if (breaches[0].deadline != deadlines[i]) return false;
+    }
+    return true;
+}
+
+static double percentile(vector<float>& values, double p) {
+    if (values.empty()) return 0;
+    size_t rank = (size_t)(p * (values.size() - 1));
+    nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+int main(int argc, char* argv[]) {
+    SimConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        cout << "Usage: ed_simulator [days=365] [rate=1000] [bays=820] [seed=1]\n"
+             << "                    [surge-every=24] [surge-length=2] [surge-factor=3]\n"
+             << "                    [mix=w1,...,w10] [treat=standard,urgent,critical]\n"
+             << "                    [service=lognormal|exp|fixed]\n";
+        return 1;
+    }
+
+    mt19937_64 rng(config.seed);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    exponential_distribution<double> interArrival(config.ratePerHour * config.surgeFactor / 60.0);
+    discrete_distribution<int> triage(config.mix.begin(), config.mix.end());
+    double logSigma = sqrt(log(2.0));   // lognormal with coefficient of variation 1
+
+    auto treatmentMinutes = [&](int priority) {
+        double mean = config.treatMinutes[priorityClass(priority)];
+        if (config.service == "fixed") return mean;
+        if (config.service == "exp") return exponential_distribution<double>(1.0 / mean)(rng);
+        return lognormal_distribution<double>(log(mean) - logSigma * logSigma / 2, logSigma)(rng);
+    };
+    auto inSurge = [&](double minute) {
+        return config.surgeFactor > 1 &&
+               fmod(minute / 60.0, config.surgeEveryHours) < config.surgeLengthHours;
+    };
+
+    // ED engine under test
+    EmergencyPriorityQueue queue(1024);
+    TreatmentBoard board;
+    SlaTimingWheel slaWheel(0);
+
+    SimEventQueue events(1024);
+    double endMinute = config.days * 24 * 60;
+    int freeBays = config.bays;
+    int nextCaseID = 1;
+
+    long long eventCount = 0;
+    long long engineOps = 0;
+    long long arrived = 0;
+    long long treated = 0;
+    vector<vector<float> > waitsByPriority(PriorityHistogram::MAX_PRIORITY + 1);
+    long long breachesByPriority[PriorityHistogram::MAX_PRIORITY + 1] = { 0 };
+    vector<SlaTimingWheel::Breach> breaches;
+    vector<float> hourlyQueueLength;
+    double queueArea = 0;          // integral of queue length over time
+    double lastMinute = 0;
+    int maxQueueLength = 0;
+
+    // Start every free bay on the most critical waiting cases
+    auto startTreatments = [&](double now) {
+        while (freeBays > 0 && !queue.isEmpty()) {
+            EmergencyCase next = queue.extractMostCritical();
+            slaWheel.cancel(next.caseID);
+            waitsByPriority[next.priorityLevel].push_back(
+                (float)(now - next.arrivalTimeRaw / 60.0));
+
+            SimEvent done;
+            done.minute = now + treatmentMinutes(next.priorityLevel);
+            done.type = EVENT_TREATMENT_DONE;
+            done.handle = board.admit(next, "T+" + to_string((long long)now) + "m");
+            events.push(done);
+            freeBays--;
+            engineOps += 3;
+        }
+    };
+
+    auto scheduleArrival = [&](double from) {
+        double minute = from;
+        do {
+            minute += interArrival(rng);
+        } while (!inSurge(minute) && unit(rng) * config.surgeFactor > 1.0);
+        SimEvent arrival;
+        arrival.minute = minute;
+        arrival.type = EVENT_ARRIVAL;
+        events.push(arrival);
+    };
+
+    scheduleArrival(0);
+    SimEvent sample;
+    sample.minute = 60;
+    sample.type = EVENT_HOURLY_SAMPLE;
+    events.push(sample);
+
+    steady_clock::time_point wallStart = steady_clock::now();
+
+    while (!events.empty() && events.top().minute <= endMinute) {
+        SimEvent event = events.pop();
+        double now = event.minute;
+        eventCount++;
+
+        queueArea += queue.getSize() * (now - lastMinute);
+        lastMinute = now;
+
+        // SLA deadlines that expired while waiting
+        breaches.clear();
+        slaWheel.advance((time_t)(now * 60), breaches);
+        for (size_t i = 0; i < breaches.size(); i++) {
+            breachesByPriority[breaches[i].priority]++;
+        }
+
+        switch (event.type) {
+            case EVENT_ARRIVAL: {
+                EmergencyCase c;
+                c.caseID = nextCaseID++;
+                c.priorityLevel = triage(rng) + 1;
+                c.arrivalTimeRaw = (time_t)(now * 60);
+                queue.insertEmergencyCase(c);
+                slaWheel.schedule(c.caseID, c.priorityLevel, c.arrivalTimeRaw + slaSeconds(c.priorityLevel));
+                engineOps += 2;
+                arrived++;
+                if (queue.getSize() > maxQueueLength) maxQueueLength = queue.getSize();
+                startTreatments(now);
+                scheduleArrival(now);
+                break;
+            }
+            case EVENT_TREATMENT_DONE:
+                board.complete(event.handle);
+                engineOps++;
+                treated++;
+                freeBays++;
+                startTreatments(now);
+                break;
+            case EVENT_HOURLY_SAMPLE:
+                hourlyQueueLength.push_back((float)queue.getSize());
+                event.minute += 60;
+                events.push(event);
+                break;
+        }
+    }
+
+    double wallSeconds = duration<double>(steady_clock::now() - wallStart).count();
+    bool conserved = arrived == treated + board.size() + queue.getSize();
+
+    cout << "ED simulation: " << config.days << " days, " << config.ratePerHour << " arrivals/h, "
+         << config.bays << " bays, surge x" << config.surgeFactor << " for "
+         << config.surgeLengthHours << "h every " << config.surgeEveryHours << "h, "
+         << config.service << " treatment times\n\n";
+
+    cout << fixed << setprecision(1);
+    cout << "Cases arrived: " << arrived << ", treated: " << treated
+         << ", in treatment: " << board.size() << ", still queued: " << queue.getSize() << endl;
+    cout << "Queue length: mean " << (lastMinute > 0 ? queueArea / lastMinute : 0)
+         << ", hourly p50 " << percentile(hourlyQueueLength, 0.50)
+         << ", hourly p95 " << percentile(hourlyQueueLength, 0.95)
+         << ", max " << maxQueueLength << "\n\n";
+
+    cout << "Wait until treatment (minutes)\n";
+    cout << right << setw(8) << "priority" << setw(11) << "started" << setw(10) << "mean"
+         << setw(10) << "p50" << setw(10) << "p90" << setw(10) << "p99" << setw(10) << "max"
+         << setw(12) << "SLA breach" << endl;
+    for (int p = PriorityHistogram::MAX_PRIORITY; p >= 1; p--) {
+        vector<float>& waits = waitsByPriority[p];
+        double sum = 0;
+        for (size_t i = 0; i < waits.size(); i++) sum += waits[i];
+        double maxWait = waits.empty() ? 0 : *max_element(waits.begin(), waits.end());
+        cout << setw(8) << p << setw(11) << waits.size()
+             << setw(10) << (waits.empty() ? 0 : sum / waits.size())
+             << setw(10) << percentile(waits, 0.50) << setw(10) << percentile(waits, 0.90)
+             << setw(10) << percentile(waits, 0.99) << setw(10) << maxWait
+             << setw(12) << breachesByPriority[p] << endl;
+    }
+
+    cout << "\nEvents processed: " << eventCount << " in " << setprecision(2) << wallSeconds << " s\n";
+    cout << setprecision(0);
+    cout << "events/s:     " << eventCount / wallSeconds << endl;
+    cout << "engine ops/s: " << engineOps / wallSeconds << "  (queue, board and SLA calls; wall clock)\n";
+    cout << "case conservation check: " << (conserved ? "ok" : "FAILED") << endl;
+
+    bool boundaryOk = slaBoundaryOk();
+    cout << "SLA boundary check: " << (boundaryOk ? "ok" : "FAILED") << endl;
+
+    return conserved && boundaryOk ? 0 : 1;
+}
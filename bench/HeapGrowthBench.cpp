@@ -0,0 +1,164 @@
+// ============================================================================
+// HeapGrowthBench.cpp
+// Insert-storm latency for EmergencyPriorityQueue growth
+// ----------------------------------------------------------------------------
+// Compares three ways of absorbing a burst of cases:
+//   legacy-copy  → the original resizeHeap (copy-assign every case on growth)
+//   move-growth  → current resizeHeap (cases are moved, no string copies)
+//   reserved     → reserve(n) before the storm, so no growth at all
+// Per-insert latency is reported as percentiles; the max column shows the
+// spike caused by the largest reallocation. The reserved queue is then
+// drained to 5% and to empty: both the heap array and the case pool must
+// shrink with it, and the partly drained heap must still pop in order.
+//
+// Build: g++ -std=gnu++14 -O2 bench/HeapGrowthBench.cpp -o heap_growth_bench
+// Usage: ./heap_growth_bench [cases=200000]
+// ============================================================================
+
+#include "../EmergencyDepartment.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+// The pre-change growth path, kept here only as the "before" reference
+// (console message removed so it does not dominate the measurement)
+class LegacyCopyGrowthHeap {
+private:
+    EmergencyCase* heap;
+    int capacity;
+    int currentSize;
+
+    void resizeHeap() {
+        int newCapacity = capacity * 2;
+        EmergencyCase* newHeap = new EmergencyCase[newCapacity];
+        for (int i = 0; i < currentSize; i++) {
+            newHeap[i] = heap[i];
+        }
+        delete[] heap;
+        heap = newHeap;
+        capacity = newCapacity;
+    }
+
+public:
+    LegacyCopyGrowthHeap(int initialCapacity) {
+        capacity = initialCapacity;
+        currentSize = 0;
+        heap = new EmergencyCase[capacity];
+    }
+
+    ~LegacyCopyGrowthHeap() {
+        delete[] heap;
+    }
+
+    void insertEmergencyCase(EmergencyCase newCase) {
+        if (currentSize == capacity) {
+            resizeHeap();
+        }
+        heap[currentSize] = newCase;
+        int index = currentSize++;
+        while (index > 0 && heap[(index - 1) / 2].priorityLevel < heap[index].priorityLevel) {
+            EmergencyCase temp = heap[index];
+            heap[index] = heap[(index - 1) / 2];
+            heap[(index - 1) / 2] = temp;
+            index = (index - 1) / 2;
+        }
+    }
+};
+
+// Cases with strings long enough to defeat the small-string optimisation
+static vector<EmergencyCase> makeCases(int count) {
+    vector<EmergencyCase> cases;
+    cases.reserve(count);
+    unsigned seed = 12345;
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int priority = 1 + (int)((seed >> 16) % 10);
+        cases.push_back(EmergencyCase(i, "Transferred Patient Number " + to_string(i),
+                                      "Multiple Trauma From Transfer", priority,
+                                      "Arrived as part of a regional surge transfer"));
+    }
+    return cases;
+}
+
+template <typename Queue>
+static void runStorm(const char* label, Queue& queue, const vector<EmergencyCase>& cases) {
+    vector<double> latencies;
+    latencies.reserve(cases.size());
+
+    steady_clock::time_point stormStart = steady_clock::now();
+    for (size_t i = 0; i < cases.size(); i++) {
+        steady_clock::time_point t0 = steady_clock::now();
+        queue.insertEmergencyCase(cases[i]);
+        steady_clock::time_point t1 = steady_clock::now();
+        latencies.push_back(duration<double, nano>(t1 - t0).count());
+    }
+    double totalMs = duration<double, milli>(steady_clock::now() - stormStart).count();
+
+    sort(latencies.begin(), latencies.end());
+    size_t n = latencies.size();
+    cout << left << setw(14) << label
+         << right << setw(10) << fixed << setprecision(1) << totalMs
+         << setw(10) << latencies[n / 2]
+         << setw(10) << latencies[(size_t)(n * 0.99)]
+         << setw(12) << latencies[(size_t)(n * 0.999)]
+         << setw(14) << latencies[n - 1] << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int count = (argc > 1) ? atoi(argv[1]) : 200000;
+    if (count <= 0) count = 200000;
+
+    vector<EmergencyCase> cases = makeCases(count);
+
+    cout << "Insert storm of " << count << " cases (latency in ns)\n";
+    cout << left << setw(14) << "variant"
+         << right << setw(10) << "total_ms"
+         << setw(10) << "p50"
+         << setw(10) << "p99"
+         << setw(12) << "p99.9"
+         << setw(14) << "max" << endl;
+
+    {
+        LegacyCopyGrowthHeap legacy(20);
+        runStorm("legacy-copy", legacy, cases);
+    }
+    {
+        EmergencyPriorityQueue grown(20);
+        runStorm("move-growth", grown, cases);
+    }
+    bool ordered = true;
+    bool shrunk = false;
+    {
+        EmergencyPriorityQueue reserved(20);
+        reserved.reserve(count);
+        runStorm("reserved", reserved, cases);
+
+        // Drain and show the shrink policy handing memory back
+        int peak = reserved.getCapacity();
+        int peakElements = reserved.getElementCapacity();
+        while (reserved.getSize() > count / 20) {
+            reserved.extractMostCritical();
+        }
+        int partialCapacity = reserved.getCapacity();
+        int partialElements = reserved.getElementCapacity();
+        int previous = 11;
+        while (!reserved.isEmpty()) {
+            int priority = reserved.extractMostCritical().priorityLevel;
+            ordered = ordered && priority <= previous;
+            previous = priority;
+        }
+        cout << "\nCapacity (heap array / case pool) at peak: " << peak << " / " << peakElements
+             << ", at 5%: " << partialCapacity << " / " << partialElements
+             << ", drained: " << reserved.getCapacity() << " / " << reserved.getElementCapacity() << "\n";
+        // The pool is released in 256-case chunks, so allow one chunk of slack
+        shrunk = partialElements <= partialCapacity + 256 && reserved.getElementCapacity() <= 256;
+    }
+
+    bool ok = ordered && shrunk;
+    cout << "shrink check: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,557 @@
+// ============================================================================
+// HospitalDayLoad.cpp
+// End-to-end load test: a generated hospital day replayed through all roles
+// ----------------------------------------------------------------------------
+// The generator builds one correlated event stream before anything is timed:
+//   admissions   Poisson arrivals, diurnal curve (peak 18:00) times any
+//                surge windows; surges also double the Emergency share
+//   discharges   each admission leaves after an exponential stay (FIFO ward)
+//   look-ups     nurses find a recently admitted patient by ID
+//   ED cases     derived from admissions: every Emergency, most Critical and
+//                a few Normal patients are logged; each is called into a bay
+//                after a wait and completed after its treatment time
+//   supplies     every treatment dispenses a kit that depends on the case
+//                (gloves, gauze for trauma, saline/syringes for critical);
+//                pharmacy restocks each window from the forecast, purges
+//                expired batches every 6 hours
+//   ambulances   most priority 8+ cases arrive by ambulance: a unit is
+//                reserved before the admission and returns after handover;
+//                every unit also reports its position periodically
+// The stream is then replayed at full speed against PatientQueue,
+// MedicalSupply, EmergencyDepartmentOfficer and AmbulanceQueue through the
+// status-returning core API, timing every call.
+//
+//   report → events/s, latency percentiles per module and per operation,
+//            peak RSS after generating and after the replay
+//   check  → every call returns the status the stream implies, and the
+//            final counts match the stream
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/HospitalDayLoad.cpp PatientAdmission.cpp MedicalSupply.cpp Ambulance.cpp -o hospital_day_load
+// Usage: ./hospital_day_load [--days=7] [--admissions=3000] [--units=40] [--telemetry=120]
+//                            [--surge=START_HOUR:HOURS:MULTIPLIER ...]
+// ============================================================================
+
+#include "../PatientAdmission.hpp"
+#include "../MedicalSupply.hpp"
+#include "../EmergencyDepartment.hpp"
+#include "../Ambulance.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <iomanip>
+#include <sys/resource.h>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+enum EventKind {
+    EV_ADMIT = 0,
+    EV_DISCHARGE,
+    EV_PATIENT_FIND,
+    EV_ED_LOG,
+    EV_ED_CALL,
+    EV_ED_COMPLETE,
+    EV_SUPPLY_DISPENSE,
+    EV_SUPPLY_RESTOCK,
+    EV_SUPPLY_PURGE,
+    EV_AMB_DISPATCH,
+    EV_AMB_RETURN,
+    EV_AMB_POSITION,
+    EV_KIND_COUNT
+};
+
+static const char* kindNames[EV_KIND_COUNT] = {
+    "admit", "discharge", "find", "log", "call", "complete",
+    "dispense", "restock", "purge", "dispatch", "return", "position"
+};
+
+enum Module { MOD_PATIENT = 0, MOD_ED, MOD_SUPPLY, MOD_AMBULANCE, MOD_COUNT };
+
+static const char* moduleNames[MOD_COUNT] = { "Patient", "Emergency", "Supply", "Ambulance" };
+
+static Module moduleOf(int kind) {
+    if (kind <= EV_PATIENT_FIND) return MOD_PATIENT;
+    if (kind <= EV_ED_COMPLETE) return MOD_ED;
+    if (kind <= EV_SUPPLY_PURGE) return MOD_SUPPLY;
+    return MOD_AMBULANCE;
+}
+
+// What `ref` means depends on the kind: admission index (admit, find, log),
+// dispatch index (dispatch, return), unit index (position)
+struct WorkloadEvent {
+    double at;          // seconds since the start of the run
+    unsigned char kind;
+    unsigned char detail; // condition, case type or supply type
+    short amount;         // priority or quantity
+    int ref;
+};
+
+static const char* conditions[] = { "Normal", "Critical", "Emergency" };
+
+struct CaseType {
+    const char* name;
+    int condition;
+    int minPriority;
+    int maxPriority;
+};
+
+static const CaseType caseTypes[] = {
+    { "Abdominal Pain", 0, 1, 4 },
+    { "Laceration Wound", 0, 1, 4 },
+    { "Fever", 0, 1, 4 },
+    { "Fracture", 1, 5, 8 },
+    { "Burn Injury", 1, 5, 8 },
+    { "Respiratory Distress", 1, 5, 8 },
+    { "Cardiac Arrest", 2, 8, 10 },
+    { "Severe Trauma", 2, 8, 10 },
+    { "Stroke Symptoms", 2, 8, 10 },
+};
+
+enum SupplyType { SUP_GLOVES = 0, SUP_GAUZE, SUP_SYRINGE, SUP_SALINE, SUP_COUNT };
+
+static const char* supplyNames[SUP_COUNT] = { "Gloves", "Gauze", "Syringe", "Saline" };
+
+struct Surge {
+    double startHour;
+    double hours;
+    double multiplier;
+};
+
+struct LoadConfig {
+    int days;
+    double admissionsPerDay;
+    int units;
+    double telemetrySeconds;
+    vector<Surge> surges;
+};
+
+static unsigned seed = 20240917u;
+
+static unsigned nextRandom() {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+static double uniform() {
+    return (nextRandom() + 0.5) / 16777216.0;
+}
+
+static double exponential(double mean) {
+    return -log(uniform()) * mean;
+}
+
+static int between(int low, int high) {
+    return low + (int)(nextRandom() % (unsigned)(high - low + 1));
+}
+
+static double surgeFactor(const LoadConfig& cfg, double hour) {
+    double factor = 1.0;
+    for (size_t i = 0; i < cfg.surges.size(); i++) {
+        const Surge& s = cfg.surges[i];
+        if (hour >= s.startHour && hour < s.startHour + s.hours) factor = max(factor, s.multiplier);
+    }
+    return factor;
+}
+
+static double admissionRate(const LoadConfig& cfg, double at) {
+    double hour = at / 3600.0;
+    double diurnal = 1.0 + 0.4 * sin(2 * M_PI * (fmod(hour, 24.0) - 12.0) / 24.0);
+    return cfg.admissionsPerDay / 86400.0 * diurnal * surgeFactor(cfg, hour);
+}
+
+static void addEvent(vector<WorkloadEvent>& stream, double at, int kind, int detail, int amount, int ref) {
+    WorkloadEvent e;
+    e.at = at;
+    e.kind = (unsigned char)kind;
+    e.detail = (unsigned char)detail;
+    e.amount = (short)amount;
+    e.ref = ref;
+    stream.push_back(e);
+}
+
+// ============================================================================
+// Generator
+// ============================================================================
+
+static void addTreatmentKit(vector<WorkloadEvent>& stream, double at, const CaseType& type) {
+    addEvent(stream, at, EV_SUPPLY_DISPENSE, SUP_GLOVES, 2, 0);
+    if (BayAllocator::requiredCapability(EmergencyCase(0, "x", type.name, type.minPriority)) == BAY_TRAUMA) {
+        addEvent(stream, at, EV_SUPPLY_DISPENSE, SUP_GAUZE, 3, 0);
+    }
+    if (type.condition == 2) {
+        addEvent(stream, at, EV_SUPPLY_DISPENSE, SUP_SALINE, 2, 0);
+        addEvent(stream, at, EV_SUPPLY_DISPENSE, SUP_SYRINGE, 2, 0);
+    } else {
+        addEvent(stream, at, EV_SUPPLY_DISPENSE, SUP_SYRINGE, 1, 0);
+    }
+}
+
+static vector<WorkloadEvent> generate(const LoadConfig& cfg) {
+    vector<WorkloadEvent> stream;
+    double end = cfg.days * 86400.0;
+
+    double peakRate = cfg.admissionsPerDay / 86400.0 * 1.4;
+    for (size_t i = 0; i < cfg.surges.size(); i++) {
+        peakRate = max(peakRate, cfg.admissionsPerDay / 86400.0 * 1.4 * cfg.surges[i].multiplier);
+    }
+
+    int admissions = 0;
+    int dispatches = 0;
+    double at = 0;
+    while (true) {
+        // Thinning: candidate arrivals at the peak rate, kept at rate(at)/peak
+        at += exponential(1.0 / peakRate);
+        if (at >= end) break;
+        if (uniform() * peakRate > admissionRate(cfg, at)) continue;
+
+        bool surge = surgeFactor(cfg, at / 3600.0) > 1.0;
+        double roll = uniform();
+        int condition = roll < (surge ? 0.16 : 0.08) ? 2 : (roll < (surge ? 0.36 : 0.28) ? 1 : 0);
+        int patient = admissions++;
+
+        addEvent(stream, at, EV_ADMIT, condition, 0, patient);
+        addEvent(stream, at + exponential(6 * 3600.0), EV_DISCHARGE, 0, 0, patient);
+        if (uniform() < 0.5) {
+            int recent = patient - (int)(nextRandom() % (unsigned)min(patient + 1, 400));
+            addEvent(stream, at + exponential(1800.0), EV_PATIENT_FIND, 0, 0, recent);
+        }
+
+        double toED = condition == 2 ? 1.0 : (condition == 1 ? 0.7 : 0.1);
+        if (uniform() >= toED) continue;
+
+        int typeIndex = condition * 3 + between(0, 2);
+        const CaseType& type = caseTypes[typeIndex];
+        int priority = between(type.minPriority, type.maxPriority);
+        addEvent(stream, at, EV_ED_LOG, typeIndex, priority, patient);
+
+        double called = at + 1 + exponential(priority >= 8 ? 300.0 : (priority >= 5 ? 1200.0 : 3600.0));
+        double finished = called + 1 + exponential(priority >= 8 ? 5400.0 : 2400.0);
+        addEvent(stream, called, EV_ED_CALL, 0, 0, patient);
+        addTreatmentKit(stream, called, type);
+        addEvent(stream, finished, EV_ED_COMPLETE, 0, 0, patient);
+
+        if (priority >= 8 && uniform() < 0.7) {
+            double sent = max(0.0, at - between(8, 25) * 60.0);
+            addEvent(stream, sent, EV_AMB_DISPATCH, 0, 0, dispatches);
+            addEvent(stream, at + between(30, 60) * 60.0, EV_AMB_RETURN, 0, 0, dispatches);
+            dispatches++;
+        }
+    }
+
+    // Pharmacy: each 4-hour window is stocked from its forecast demand + 10%
+    const double window = 4 * 3600.0;
+    int windows = (int)ceil(end / window) + 1;
+    vector<vector<int>> demand(windows, vector<int>(SUP_COUNT, 0));
+    for (size_t i = 0; i < stream.size(); i++) {
+        if (stream[i].kind == EV_SUPPLY_DISPENSE && stream[i].at < end) {
+            demand[(int)(stream[i].at / window)][stream[i].detail] += stream[i].amount;
+        }
+    }
+    for (int w = 0; w < windows && w * window < end; w++) {
+        for (int s = 0; s < SUP_COUNT; s++) {
+            if (demand[w][s] > 0) addEvent(stream, w * window, EV_SUPPLY_RESTOCK, s, (int)ceil(demand[w][s] * 1.1), 0);
+        }
+    }
+    for (double t = 6 * 3600.0; t < end; t += 6 * 3600.0) {
+        addEvent(stream, t, EV_SUPPLY_PURGE, 0, 0, 0);
+    }
+
+    for (int unit = 0; unit < cfg.units; unit++) {
+        for (double t = uniform() * cfg.telemetrySeconds; t < end; t += cfg.telemetrySeconds) {
+            addEvent(stream, t, EV_AMB_POSITION, 0, 0, unit);
+        }
+    }
+
+    // Same timestamp keeps generation order (admit before its ED log, ...)
+    stable_sort(stream.begin(), stream.end(),
+                [](const WorkloadEvent& a, const WorkloadEvent& b) { return a.at < b.at; });
+    while (!stream.empty() && stream.back().at >= end) stream.pop_back();
+    return stream;
+}
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+struct ReplayResult {
+    vector<vector<long long>> latencyNs; // per event kind
+    long long eventCount;
+    double seconds;
+    long long admitted;
+    long long discharged;
+    long long findHits;
+    long long edCalledWaiting;  // called with no compatible bay free
+    long long edHandedOver;     // waiting cases given a freed bay
+    long long supplyShortages;
+    long long dispatchUnavailable;
+    int finalPatients;
+    int finalPending;
+    int finalInTreatment;
+    int finalUnitsOut;
+    int finalSupplyBatches;
+    long long unexpected;       // calls that returned something else
+};
+
+static string patientID(int index) {
+    char id[16];
+    snprintf(id, sizeof(id), "P%03d", index + 1);
+    return id;
+}
+
+static string expiryNextYear() {
+    time_t later = time(nullptr) + 365L * 86400L;
+    char date[16];
+    strftime(date, sizeof(date), "%Y-%m-%d", localtime(&later));
+    return date;
+}
+
+static ReplayResult replay(const LoadConfig& cfg, const vector<WorkloadEvent>& stream) {
+    ReplayResult r;
+    r.eventCount = (long long)stream.size();
+    r.admitted = r.discharged = r.findHits = 0;
+    r.edCalledWaiting = r.edHandedOver = r.supplyShortages = r.dispatchUnavailable = 0;
+    r.unexpected = 0;
+
+    vector<long long> perKind(EV_KIND_COUNT, 0);
+    int dispatches = 0;
+    for (size_t i = 0; i < stream.size(); i++) {
+        perKind[stream[i].kind]++;
+        if (stream[i].kind == EV_AMB_DISPATCH) dispatches = max(dispatches, stream[i].ref + 1);
+    }
+    r.latencyNs.resize(EV_KIND_COUNT);
+    for (int k = 0; k < EV_KIND_COUNT; k++) r.latencyNs[k].reserve(perKind[k]);
+
+    PatientQueue patients;
+    MedicalSupply supplies;
+    EmergencyDepartmentOfficer ed("Load", "ED-LOAD");
+    AmbulanceQueue fleet;
+    vector<string> unitIDs;
+    for (int u = 0; u < cfg.units; u++) {
+        unitIDs.push_back("AMB" + to_string(u + 1));
+        fleet.addAmbulance(unitIDs.back(), "Driver " + to_string(u + 1));
+    }
+
+    // Generated up front so the timed calls do no formatting
+    vector<string> supplyTypes(supplyNames, supplyNames + SUP_COUNT);
+    string expiry = expiryNextYear();
+    vector<string> unitOfDispatch(dispatches);
+    deque<int> inTreatment; // case IDs holding a bay, oldest first
+    PatientRecord record;
+    EmergencyCase called;
+    Ambulance unit;
+    string driverName;
+
+    steady_clock::time_point replayStart = steady_clock::now();
+    for (size_t i = 0; i < stream.size(); i++) {
+        const WorkloadEvent& e = stream[i];
+        OpStatus status = OP_OK;
+        bool expected = true;
+
+        // Inputs are built outside the timed region
+        string name;
+        EmergencyCase newCase;
+        string findID;
+        if (e.kind == EV_ADMIT || e.kind == EV_ED_LOG) name = "Patient " + to_string(e.ref);
+        if (e.kind == EV_ADMIT) record = PatientRecord(name, conditions[e.detail]);
+        if (e.kind == EV_ED_LOG) newCase = EmergencyCase(0, name, caseTypes[e.detail].name, e.amount);
+        if (e.kind == EV_PATIENT_FIND) findID = patientID(e.ref);
+        double x = (nextRandom() % 50000) / 1000.0;
+        double y = (nextRandom() % 50000) / 1000.0;
+
+        steady_clock::time_point started = steady_clock::now();
+        switch (e.kind) {
+            case EV_ADMIT:
+                status = patients.admit(record);
+                r.admitted += status == OP_OK;
+                break;
+            case EV_DISCHARGE:
+                status = patients.discharge(record);
+                r.discharged += status == OP_OK;
+                break;
+            case EV_PATIENT_FIND:
+                status = patients.find(findID, record);
+                r.findHits += status == OP_OK;
+                expected = status == OP_OK || status == OP_NOT_FOUND;
+                break;
+            case EV_ED_LOG:
+                status = ed.logCase(std::move(newCase));
+                break;
+            case EV_ED_CALL: {
+                int bayID = -1;
+                status = ed.callNextCase(called, bayID);
+                if (status == OP_OK && bayID != -1) inTreatment.push_back(called.caseID);
+                r.edCalledWaiting += status == OP_OK && bayID == -1;
+                break;
+            }
+            case EV_ED_COMPLETE: {
+                // The bay freed first goes back first; with no case holding a
+                // bay the stream is out of step with the ED
+                if (inTreatment.empty()) {
+                    status = OP_EMPTY;
+                    break;
+                }
+                int reassignedCaseID = -1;
+                status = ed.finishCase(inTreatment.front(), called, reassignedCaseID);
+                inTreatment.pop_front();
+                if (reassignedCaseID != -1) {
+                    inTreatment.push_back(reassignedCaseID);
+                    r.edHandedOver++;
+                }
+                break;
+            }
+            case EV_SUPPLY_DISPENSE:
+                status = supplies.dispense(supplyTypes[e.detail], e.amount);
+                r.supplyShortages += status != OP_OK;
+                expected = status == OP_OK || status == OP_INSUFFICIENT || status == OP_NOT_FOUND;
+                break;
+            case EV_SUPPLY_RESTOCK:
+                status = supplies.addStock(supplyTypes[e.detail], e.amount, expiry, "restock");
+                break;
+            case EV_SUPPLY_PURGE:
+                supplies.purgeExpired();
+                break;
+            case EV_AMB_DISPATCH:
+                status = fleet.reserveNextAvailable(unitOfDispatch[e.ref], driverName);
+                r.dispatchUnavailable += status == OP_UNAVAILABLE;
+                expected = status == OP_OK || status == OP_UNAVAILABLE;
+                break;
+            case EV_AMB_RETURN:
+                if (!unitOfDispatch[e.ref].empty()) status = fleet.setStatus(unitOfDispatch[e.ref], STATUS_AVAILABLE);
+                break;
+            case EV_AMB_POSITION:
+                status = fleet.setPosition(unitIDs[e.ref], x, y);
+                break;
+        }
+        r.latencyNs[e.kind].push_back(duration_cast<nanoseconds>(steady_clock::now() - started).count());
+
+        if (e.kind != EV_PATIENT_FIND && e.kind != EV_SUPPLY_DISPENSE && e.kind != EV_AMB_DISPATCH) {
+            expected = status == OP_OK;
+        }
+        r.unexpected += !expected;
+    }
+    r.seconds = duration<double>(steady_clock::now() - replayStart).count();
+
+    r.finalPatients = patients.count();
+    r.finalPending = ed.getPendingCount();
+    r.finalInTreatment = ed.getInTreatmentCount();
+    r.finalUnitsOut = fleet.countByStatus(STATUS_ON_DUTY);
+    r.finalSupplyBatches = supplies.getItemCount();
+    return r;
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+
+static long peakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss; // kilobytes on Linux
+}
+
+static double percentileUs(const vector<long long>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    return sorted[(size_t)(p * (sorted.size() - 1))] / 1000.0;
+}
+
+static void printRow(const string& label, vector<long long> samples) {
+    sort(samples.begin(), samples.end());
+    cout << left << setw(22) << label << right << setw(10) << samples.size() << setw(10)
+         << percentileUs(samples, 0.5) << setw(10) << percentileUs(samples, 0.99) << setw(11)
+         << percentileUs(samples, 0.999) << setw(11) << (samples.empty() ? 0 : samples.back() / 1000.0) << endl;
+}
+
+static bool parseSurge(const char* text, Surge& surge) {
+    return sscanf(text, "%lf:%lf:%lf", &surge.startHour, &surge.hours, &surge.multiplier) == 3 &&
+           surge.hours > 0 && surge.multiplier >= 1.0;
+}
+
+int main(int argc, char* argv[]) {
+    LoadConfig cfg;
+    cfg.days = 7;
+    cfg.admissionsPerDay = 3000;
+    cfg.units = 40;
+    cfg.telemetrySeconds = 120;
+    for (int i = 1; i < argc; i++) {
+        Surge surge;
+        if (strncmp(argv[i], "--days=", 7) == 0) cfg.days = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--admissions=", 13) == 0) cfg.admissionsPerDay = atof(argv[i] + 13);
+        else if (strncmp(argv[i], "--units=", 8) == 0) cfg.units = atoi(argv[i] + 8);
+        else if (strncmp(argv[i], "--telemetry=", 12) == 0) cfg.telemetrySeconds = atof(argv[i] + 12);
+        else if (strncmp(argv[i], "--surge=", 8) == 0 && parseSurge(argv[i] + 8, surge)) cfg.surges.push_back(surge);
+        else {
+            cerr << "Usage: " << argv[0] << " [--days=7] [--admissions=3000] [--units=40] [--telemetry=120]"
+                 << " [--surge=START_HOUR:HOURS:MULTIPLIER ...]\n";
+            return 2;
+        }
+    }
+    if (cfg.days < 1 || cfg.admissionsPerDay <= 0 || cfg.units < 1 || cfg.telemetrySeconds <= 0) {
+        cerr << "days, admissions, units and telemetry must be positive\n";
+        return 2;
+    }
+    if (cfg.surges.empty()) {
+        Surge evening = { 17, 3, 4 }; // mass-casualty evening on day one
+        cfg.surges.push_back(evening);
+    }
+
+    cout << "Hospital load: " << cfg.days << " day(s), " << (long)cfg.admissionsPerDay << " admissions/day, "
+         << cfg.units << " ambulances, position every " << cfg.telemetrySeconds << " s\n";
+    for (size_t i = 0; i < cfg.surges.size(); i++) {
+        cout << "surge: hour " << cfg.surges[i].startHour << " for " << cfg.surges[i].hours << " h, x"
+             << cfg.surges[i].multiplier << "\n";
+    }
+
+    steady_clock::time_point genStart = steady_clock::now();
+    vector<WorkloadEvent> stream = generate(cfg);
+    double genMs = duration<double, milli>(steady_clock::now() - genStart).count();
+    long rssAfterGenerate = peakRssKb();
+
+    vector<long long> perKind(EV_KIND_COUNT, 0);
+    for (size_t i = 0; i < stream.size(); i++) perKind[stream[i].kind]++;
+
+    ReplayResult r = replay(cfg, stream);
+    long rssAfterReplay = peakRssKb();
+
+    cout << fixed << setprecision(1);
+    cout << "generated " << stream.size() << " events in " << genMs << " ms\n";
+    cout << "replayed in " << setprecision(3) << r.seconds << " s: " << setprecision(0)
+         << r.eventCount / r.seconds << " events/s\n\n" << setprecision(1);
+
+    cout << left << setw(22) << "module / operation" << right << setw(10) << "calls" << setw(10) << "p50 us"
+         << setw(10) << "p99 us" << setw(11) << "p99.9 us" << setw(11) << "max us" << endl;
+    for (int m = 0; m < MOD_COUNT; m++) {
+        vector<long long> all;
+        for (int k = 0; k < EV_KIND_COUNT; k++) {
+            if (moduleOf(k) == m) all.insert(all.end(), r.latencyNs[k].begin(), r.latencyNs[k].end());
+        }
+        printRow(moduleNames[m], all);
+        for (int k = 0; k < EV_KIND_COUNT; k++) {
+            if (moduleOf(k) == m) printRow(string("  ") + kindNames[k], r.latencyNs[k]);
+        }
+    }
+
+    cout << "\nward at end: " << r.finalPatients << " patients, " << r.findHits << "/" << perKind[EV_PATIENT_FIND]
+         << " look-ups found\n";
+    cout << "ED at end: " << r.finalPending << " pending, " << r.finalInTreatment << " in treatment; "
+         << r.edCalledWaiting << " calls waited for a bay, " << r.edHandedOver << " handed a freed bay\n";
+    cout << "supplies: " << r.supplyShortages << " short dispenses, " << r.finalSupplyBatches << " batches left\n";
+    cout << "ambulances: " << r.dispatchUnavailable << "/" << perKind[EV_AMB_DISPATCH]
+         << " dispatches found no unit, " << r.finalUnitsOut << " out at end\n";
+    cout << "peak RSS: " << rssAfterGenerate / 1024.0 << " MB after generating, " << rssAfterReplay / 1024.0
+         << " MB after replay\n";
+
+    bool ok = r.unexpected == 0 && r.admitted == perKind[EV_ADMIT] && r.discharged == perKind[EV_DISCHARGE] &&
+              r.finalPatients == perKind[EV_ADMIT] - perKind[EV_DISCHARGE] &&
+              r.finalPending == perKind[EV_ED_LOG] - perKind[EV_ED_CALL] &&
+              r.finalInTreatment == (int)(perKind[EV_ED_CALL] - perKind[EV_ED_COMPLETE] -
+                                          (r.edCalledWaiting - r.edHandedOver)) &&
+              r.finalUnitsOut <= cfg.units;
+    cout << "load check: " << (ok ? "ok" : "FAILED") << " (" << r.unexpected << " unexpected statuses)" << endl;
+    return ok ? 0 : 1;
+}
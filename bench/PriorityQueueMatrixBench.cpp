@@ -0,0 +1,105 @@
+// ============================================================================
+// PriorityQueueMatrixBench.cpp
+// Layout matrix for the ED heap: arity 2/4/8 x inline/indirect storage
+// ----------------------------------------------------------------------------
+// Workloads (ED case mix: ~15% critical, ~35% urgent, ~50% standard):
+//   fill+drain → push n cases, then pop all of them
+//   steady     → hold n cases, then alternate push/pop n times
+// Results are ns per operation (best of 3). The position tracker used by
+// EmergencyPriorityQueue is left out so only the layout is compared.
+//
+// Build: g++ -std=gnu++14 -O2 bench/PriorityQueueMatrixBench.cpp -o pq_matrix_bench
+// Usage: ./pq_matrix_bench [cases=100000]
+// ============================================================================
+
+#include "../EmergencyDepartment.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static vector<EmergencyCase> makeCaseMix(int count) {
+    vector<EmergencyCase> cases;
+    cases.reserve(count);
+    unsigned seed = 4242u;
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int roll = (int)((seed >> 16) % 100);
+        int priority;
+        if (roll < 15) {
+            priority = 8 + roll % 3;
+        } else if (roll < 50) {
+            priority = 5 + roll % 3;
+        } else {
+            priority = 1 + roll % 4;
+        }
+        cases.push_back(EmergencyCase(i, "Patient " + to_string(i), "Walk-in", priority));
+    }
+    return cases;
+}
+
+template <unsigned Arity, template <typename> class Storage>
+static void runLayout(const char* storageName, const vector<EmergencyCase>& cases) {
+    typedef PriorityQueue<EmergencyCase, CasePriorityKey, less<int>, Arity, Storage> Heap;
+    size_t n = cases.size();
+    double bestFill = 1e300;
+    double bestSteady = 1e300;
+    long long checksum = 0;
+    bool ordered = true;
+
+    for (int repeat = 0; repeat < 3; repeat++) {
+        {
+            Heap heap(16);
+            steady_clock::time_point t0 = steady_clock::now();
+            for (size_t i = 0; i < n; i++) heap.push(cases[i]);
+            int previous = PriorityHistogram::MAX_PRIORITY;
+            while (!heap.empty()) {
+                int priority = heap.pop().priorityLevel;
+                ordered = ordered && priority <= previous;
+                previous = priority;
+                checksum += priority;
+            }
+            double ns = duration<double, nano>(steady_clock::now() - t0).count() / (2.0 * n);
+            if (ns < bestFill) bestFill = ns;
+        }
+        {
+            Heap heap(16);
+            heap.pushBatch(cases.begin(), cases.end());
+            steady_clock::time_point t0 = steady_clock::now();
+            for (size_t i = 0; i < n; i++) {
+                heap.push(cases[n - 1 - i]);
+                checksum += heap.pop().priorityLevel;
+            }
+            double ns = duration<double, nano>(steady_clock::now() - t0).count() / (2.0 * n);
+            if (ns < bestSteady) bestSteady = ns;
+        }
+    }
+
+    cout << left << setw(8) << Arity << setw(12) << storageName
+         << right << fixed << setprecision(1)
+         << setw(16) << bestFill << setw(16) << bestSteady
+         << "   order " << (ordered ? "ok" : "BROKEN")
+         << " (checksum " << checksum % 1000 << ")" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int count = (argc > 1) ? atoi(argv[1]) : 100000;
+    if (count <= 0) count = 100000;
+
+    vector<EmergencyCase> cases = makeCaseMix(count);
+
+    cout << "ED heap layouts with " << count << " cases (ns/op, best of 3)\n";
+    cout << left << setw(8) << "arity" << setw(12) << "storage"
+         << right << setw(16) << "fill+drain" << setw(16) << "steady" << endl;
+
+    runLayout<2, InlineStorage>("inline", cases);
+    runLayout<4, InlineStorage>("inline", cases);
+    runLayout<8, InlineStorage>("inline", cases);
+    runLayout<2, IndirectStorage>("indirect", cases);
+    runLayout<4, IndirectStorage>("indirect", cases);
+    runLayout<8, IndirectStorage>("indirect", cases);
+
+    return 0;
+}
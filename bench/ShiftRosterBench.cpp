@@ -0,0 +1,251 @@
+// ============================================================================
+// ShiftRosterBench.cpp
+// Point-in-time roster queries: checkpoints + bounded replay vs full replay
+// ----------------------------------------------------------------------------
+// Logs a long rotation history (default 10^6 events about five minutes apart:
+// 90% rotations, mostly by one, some by up to 50; 10% registrations and
+// removals, holding the fleet at about 500 units). A deque model plays the
+// live ring: it supplies the checkpoints and records the true roster at 2000
+// random times.
+//
+//   frontAt    → who was on shift (checkpoint search + bounded replay)
+//   rosterAt   → the whole rotation, front first
+//   full replay→ replaying the log from the first event, as without
+//                checkpoints
+// Every answer is compared with the model. Times after `now` are checked
+// against the projection (one rotation per 8 h shift boundary). Finally,
+// AmbulanceQueue::rotateBy must match repeated rotateOnce calls (ring and
+// dispatch order), and a rotation by ~10^18 must land on k mod n.
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/ShiftRosterBench.cpp Ambulance.cpp -o shift_roster_bench
+// Usage: ./shift_roster_bench [events=1000000] [checkpointEvery=64]
+// ============================================================================
+
+#include "../Ambulance.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static unsigned seed = 987654321u;
+
+static unsigned nextRandom()
+{
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+static double percentile(vector<double>& values, double p)
+{
+    if (values.empty())
+        return 0;
+    size_t rank = (size_t)(p * (values.size() - 1));
+    nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+// Reference: replay every event from the start on a front-first deque
+static deque<int> fullReplay(const vector<RosterEvent>& log, long long t)
+{
+    deque<int> order;
+    for (size_t i = 0; i < log.size() && log[i].time <= t; i++)
+    {
+        const RosterEvent& e = log[i];
+        if (e.type == ROSTER_REGISTER)
+            order.push_back(e.value);
+        else if (e.type == ROSTER_REMOVE)
+            order.erase(find(order.begin(), order.end(), e.value));
+        else if (!order.empty())
+            for (int k = e.value % (int)order.size(); k > 0; k--)
+            {
+                order.push_back(order.front());
+                order.pop_front();
+            }
+    }
+    return order;
+}
+
+// Rotation order, then the order units would be dispatched in
+static vector<string> fleetState(AmbulanceQueue& fleet)
+{
+    vector<string> state;
+    fleet.forEachInRotation([&state](const Ambulance& unit) { state.push_back(unit.id); });
+    string id, driver;
+    while (fleet.reserveNextAvailable(id, driver) == OP_OK)
+        state.push_back(id);
+    return state;
+}
+
+static void buildFleet(AmbulanceQueue& fleet, int units)
+{
+    for (int i = 0; i < units; i++)
+        fleet.addAmbulance("AMB" + to_string(i), "Driver " + to_string(i));
+    for (int i = 0; i < units; i += 3)
+        fleet.setStatus("AMB" + to_string(i), STATUS_ON_DUTY);
+    fleet.removeAmbulance("AMB4"); // leaves an interior tombstone
+}
+
+static bool rotateByOk()
+{
+    const int UNITS = 11; // 10 live
+    const long long HUGE_K = 1000000000000000003LL;
+    bool ok = true;
+    long long ks[] = { 0, 1, 4, 6, 9, 10, 13, 27 };
+    for (size_t i = 0; i < sizeof(ks) / sizeof(ks[0]); i++)
+    {
+        AmbulanceQueue byK, oneByOne;
+        buildFleet(byK, UNITS);
+        buildFleet(oneByOne, UNITS);
+        string front;
+        ok = ok && byK.rotateBy(ks[i]) == OP_OK;
+        for (long long r = 0; r < ks[i]; r++)
+            oneByOne.rotateOnce(front);
+        ok = ok && fleetState(byK) == fleetState(oneByOne);
+    }
+
+    // Past one full cycle only k mod n counts
+    AmbulanceQueue huge, reference;
+    buildFleet(huge, UNITS);
+    buildFleet(reference, UNITS);
+    string front;
+    ok = ok && huge.rotateBy(HUGE_K) == OP_OK && huge.rotateBy(-1) == OP_INVALID_ARGUMENT;
+    for (long long r = 0; r < 10 + HUGE_K % 10; r++)
+        reference.rotateOnce(front);
+    ok = ok && fleetState(huge) == fleetState(reference);
+
+    ShiftRoster roster;
+    for (int i = 0; i < 7; i++)
+        roster.registerUnit("AMB" + to_string(i), 1000);
+    roster.rotate(HUGE_K, 2000);
+    return ok && roster.frontAt(3000, 3000) == (int)(HUGE_K % 7);
+}
+
+int main(int argc, char* argv[])
+{
+    int eventTarget = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int checkpointEvery = (argc > 2) ? atoi(argv[2]) : 64;
+    if (eventTarget <= 0)
+        eventTarget = 1000000;
+    if (checkpointEvery <= 0)
+        checkpointEvery = 64;
+
+    ShiftRoster roster(checkpointEvery);
+    roster.setShiftSchedule(7 * 3600, 8 * 3600);
+    deque<int> model;              // live rotation, front first
+    vector<RosterEvent> log;       // what the roster was told, for the full replay
+    long long clock = 1700000000;  // simulated seconds
+
+    // Query times inside the logged span (events average ~300 s apart),
+    // sorted, and the true roster at each one
+    const int QUERIES = 2000;
+    vector<long long> queryTimes;
+    for (int i = 0; i < QUERIES; i++)
+        queryTimes.push_back(clock + (long long)(nextRandom() % 1000000) * eventTarget * 290 / 1000000);
+    sort(queryTimes.begin(), queryTimes.end());
+    vector<deque<int> > truth;
+
+    steady_clock::time_point t0 = steady_clock::now();
+    for (int i = 0; i < eventTarget; i++)
+    {
+        clock += nextRandom() % 600;
+        while (truth.size() < queryTimes.size() && queryTimes[truth.size()] < clock)
+            truth.push_back(model);
+
+        unsigned roll = nextRandom() % 100;
+        RosterEvent e = { clock, ROSTER_ROTATE, 1 };
+        if (model.size() < 10 || (roll < 10 && model.size() < 500))
+        {
+            e.type = ROSTER_REGISTER;
+            e.value = roster.registerUnit("AMB" + to_string(i), clock);
+            model.push_back(e.value);
+        }
+        else if (roll < 10)
+        {
+            e.type = ROSTER_REMOVE;
+            size_t pick = nextRandom() % model.size();
+            e.value = model[pick];
+            model.erase(model.begin() + pick);
+            roster.removeUnit(e.value, clock);
+        }
+        else
+        {
+            e.value = roll < 20 ? 1 + (int)(nextRandom() % 50) : 1;
+            roster.rotate(e.value, clock);
+            for (int k = e.value % (int)model.size(); k > 0; k--)
+            {
+                model.push_back(model.front());
+                model.pop_front();
+            }
+        }
+        log.push_back(e);
+
+        if (roster.checkpointDue())
+            roster.checkpoint(vector<int>(model.begin(), model.end()));
+    }
+    while (truth.size() < queryTimes.size())
+        truth.push_back(model);
+    double logSeconds = duration<double>(steady_clock::now() - t0).count();
+    long long now = clock;
+
+    bool ok = true;
+    vector<double> frontUs, rosterUs;
+    for (int q = 0; q < QUERIES; q++)
+    {
+        long long t = queryTimes[q];
+        steady_clock::time_point start = steady_clock::now();
+        int front = roster.frontAt(t, now);
+        frontUs.push_back(duration<double, micro>(steady_clock::now() - start).count());
+
+        start = steady_clock::now();
+        vector<int> order = roster.rosterAt(t, now);
+        rosterUs.push_back(duration<double, micro>(steady_clock::now() - start).count());
+
+        const deque<int>& expected = truth[q];
+        ok = ok && order.size() == expected.size() && equal(order.begin(), order.end(), expected.begin()) &&
+             front == (expected.empty() ? -1 : expected.front());
+    }
+
+    // Full replay on a sample of the same times
+    double replayUs = 0;
+    int replays = 0;
+    for (int q = 0; q < QUERIES; q += 100, replays++)
+    {
+        steady_clock::time_point start = steady_clock::now();
+        deque<int> order = fullReplay(log, queryTimes[q]);
+        replayUs += duration<double, micro>(steady_clock::now() - start).count();
+        ok = ok && order == truth[q];
+    }
+
+    // Projection: a week ahead, shift by shift
+    for (long long t = now; t < now + 7 * 24 * 3600; t += 3600)
+    {
+        long long n = (long long)model.size();
+        int expected = model[(size_t)(roster.shiftsBetween(now, t) % n)];
+        ok = ok && roster.frontAt(t, now) == expected && roster.rosterAt(t, now).front() == expected;
+    }
+
+    cout << "Shift roster: " << roster.eventCount() << " events over "
+         << (now - 1700000000) / 86400 << " simulated days, " << model.size() << " units now\n";
+    cout << "checkpoints: " << roster.checkpointCount() << " (every max(" << checkpointEvery
+         << ", units) events), log " << fixed << setprecision(1)
+         << roster.eventCount() * sizeof(RosterEvent) / 1048576.0 << " MB, logging "
+         << logSeconds * 1e9 / roster.eventCount() << " ns/event (incl. model)\n\n";
+    cout << left << setw(14) << "query" << right << setw(12) << "p50 us" << setw(12) << "p99 us" << endl;
+    cout << setprecision(2);
+    cout << left << setw(14) << "frontAt" << right << setw(12) << percentile(frontUs, 0.5) << setw(12)
+         << percentile(frontUs, 0.99) << endl;
+    cout << left << setw(14) << "rosterAt" << right << setw(12) << percentile(rosterUs, 0.5) << setw(12)
+         << percentile(rosterUs, 0.99) << endl;
+    cout << left << setw(14) << "full replay" << right << setw(12) << replayUs / replays << setw(12) << "(avg)"
+         << endl;
+    cout << "history and projection check: " << (ok ? "ok" : "FAILED") << endl;
+    bool rotationOk = rotateByOk();
+    cout << "rotate-by-k check: " << (rotationOk ? "ok" : "FAILED") << endl;
+
+    return (ok && rotationOk) ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+// ============================================================================
+// SnapshotBench.cpp
+// Save / cold-restore time of the ED binary snapshot
+// ----------------------------------------------------------------------------
+//   save     → EdSnapshot::write of the pending heap (+ temp file, fsync, rename)
+//   restore  → EdSnapshot::read into a fresh queue (mmap, checksum, decode
+//              into the pool in saved heap order)
+//   sla      → re-register every pending deadline in a new SlaTimingWheel,
+//              as EmergencyDepartmentOfficer::loadSnapshot does
+// The restored heap must drain in exactly the same case order as the
+// original, and a snapshot with one flipped byte must be rejected. A small
+// department must get every treated case back in its saved bay, and its
+// snapshot must be rejected by one with fewer bays. A critical case still
+// waiting for a bay must breach its SLA after an officer-level round trip.
+// Snapshots that repeat a case ID or run past nextCaseID must be rejected.
+//
+// Build: g++ -std=gnu++14 -O2 bench/SnapshotBench.cpp EmergencyDepartmentMain.cpp -o snapshot_bench
+// Usage: ./snapshot_bench [cases=1000000] [file=ed_bench.snap]
+// ============================================================================
+
+#include "../EdSnapshot.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static const char* TYPES[] = { "Trauma", "Cardiac", "Stroke", "Burns", "Fracture", "Fever" };
+
+static vector<EmergencyCase> makeCases(int count) {
+    vector<EmergencyCase> cases;
+    cases.reserve(count);
+    unsigned seed = 2024u;
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int priority = 1 + (int)((seed >> 16) % 10);
+        cases.push_back(EmergencyCase(1001 + i, "Patient " + to_string(i),
+                                      TYPES[(seed >> 8) % 6], priority, "bench"));
+    }
+    return cases;
+}
+
+static double elapsedMs(steady_clock::time_point since) {
+    return duration<double, milli>(steady_clock::now() - since).count();
+}
+
+static int slaSeconds(int priority) {
+    if (priority >= 8) return 10 * 60;
+    if (priority >= 5) return 30 * 60;
+    return 120 * 60;
+}
+
+static void addBays(BayAllocator& bays, int resus, int trauma, int general) {
+    for (int i = 0; i < resus; i++) bays.addBay(BAY_RESUS);
+    for (int i = 0; i < trauma; i++) bays.addBay(BAY_TRAUMA);
+    for (int i = 0; i < general; i++) bays.addBay(BAY_GENERAL);
+}
+
+static bool baysRoundTripOk(const string& path) {
+    BayAllocator bays;
+    addBays(bays, 2, 1, 1);
+    EmergencyPriorityQueue pending(20);
+    TreatmentBoard board;
+    EdSnapshotState state;
+    state.nextCaseID = 1007;
+    const char* types[] = { "Cardiac", "Stroke", "Fever", "Cardiac", "Fracture", "Fracture" };
+    int priorities[] = { 9, 8, 3, 9, 4, 6 };
+    for (int i = 0; i < 6; i++) {
+        EmergencyCase c(1001 + i, "Patient " + to_string(i), types[i], priorities[i], "bench");
+        if (bays.request(c) != -1) board.admit(c);
+    }
+    board.forEachInStartOrder([&](const EmergencyCase& c, const string&) {
+        state.treatmentBayIDs.push_back(bays.bayOf(c.caseID));
+    });
+    bays.forEachWaiting([&state](const EmergencyCase& c) {
+        state.awaitingBay.push_back(c);
+    });
+
+    string error;
+    if (!EdSnapshot::write(path, pending, board, state, error)) return false;
+
+    BayAllocator restoredBays;
+    addBays(restoredBays, 2, 1, 1);
+    TreatmentBoard restoredBoard;
+    EdSnapshotState restoredState;
+    bool ok = EdSnapshot::read(path, pending, restoredBoard, restoredState, restoredBays, error) &&
+              restoredState.treatmentBayIDs == state.treatmentBayIDs &&
+              restoredState.awaitingBay.size() == 2;
+    size_t treated = 0;
+    restoredBoard.forEachInStartOrder([&](const EmergencyCase& c, const string&) {
+        ok = ok && restoredBays.occupyBay(restoredState.treatmentBayIDs[treated], c) &&
+             restoredBays.bayOf(c.caseID) == bays.bayOf(c.caseID);
+        treated++;
+    });
+    ok = ok && treated == 4;
+
+    BayAllocator smaller;
+    addBays(smaller, 1, 1, 1);
+    ok = ok && !EdSnapshot::read(path, pending, restoredBoard, restoredState, smaller, error);
+    remove(path.c_str());
+    return ok;
+}
+
+// Three overdue critical cases and two resus bays: one case waits for a bay
+static bool waitlistSlaOk(const string& path) {
+    streambuf* saved = cout.rdbuf(nullptr); // checkSlaBreaches reports on stdout
+    EmergencyDepartmentOfficer before;
+    for (int i = 0; i < 3; i++) {
+        EmergencyCase c(0, "Critical " + to_string(i), "Cardiac", 9, "bench");
+        c.arrivalTimeRaw -= 3600;
+        before.logCase(std::move(c));
+    }
+    EmergencyCase called;
+    int bayID = 0;
+    for (int i = 0; i < 3; i++) {
+        before.callNextCase(called, bayID);
+    }
+
+    string error;
+    int unplaced = 0;
+    EmergencyDepartmentOfficer after;
+    bool ok = bayID == -1 && before.writeSnapshot(path, error) &&
+              after.restoreSnapshot(path, error, unplaced) && unplaced == 0;
+    remove(path.c_str());
+
+    // Overdue timers fire on the next second the wheel processes
+    this_thread::sleep_for(milliseconds(1100));
+    ok = ok && after.checkSlaBreaches() == 1;
+    cout.rdbuf(saved);
+    return ok;
+}
+
+// A case listed twice, or numbered at/after nextCaseID, must be rejected
+// without touching the queue being restored into
+static bool caseIdsCheckedOk(const string& path) {
+    EmergencyPriorityQueue pending(20);
+    vector<EmergencyCase> cases = makeCases(5);
+    pending.insertBatch(cases.begin(), cases.end());
+    TreatmentBoard board;
+    EdSnapshotState state;
+    state.nextCaseID = 1006;
+
+    EmergencyPriorityQueue target(20);
+    target.insertEmergencyCase(EmergencyCase(1, "Kept", "Fever", 2, "bench"));
+    TreatmentBoard restoredBoard;
+    EdSnapshotState restoredState;
+    BayAllocator noBays;
+    string error;
+
+    state.awaitingBay.push_back(pending.caseAt(0));
+    bool ok = EdSnapshot::write(path, pending, board, state, error) &&
+              !EdSnapshot::read(path, target, restoredBoard, restoredState, noBays, error);
+
+    state.awaitingBay.clear();
+    state.nextCaseID = 1005;
+    ok = ok && EdSnapshot::write(path, pending, board, state, error) &&
+         !EdSnapshot::read(path, target, restoredBoard, restoredState, noBays, error);
+
+    state.nextCaseID = 1006;
+    ok = ok && target.getSize() == 1 && EdSnapshot::write(path, pending, board, state, error) &&
+         EdSnapshot::read(path, target, restoredBoard, restoredState, noBays, error) &&
+         target.getSize() == 5;
+    remove(path.c_str());
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    int count = (argc > 1) ? atoi(argv[1]) : 1000000;
+    string path = (argc > 2) ? argv[2] : "ed_bench.snap";
+    if (count <= 0) count = 1000000;
+
+    EmergencyPriorityQueue original(20);
+    {
+        vector<EmergencyCase> cases = makeCases(count);
+        original.insertBatch(cases.begin(), cases.end());
+    }
+    TreatmentBoard board;
+    EdSnapshotState state;
+    state.nextCaseID = 1001 + count;
+
+    string error;
+    steady_clock::time_point t0 = steady_clock::now();
+    if (!EdSnapshot::write(path, original, board, state, error)) {
+        cout << "save failed: " << error << endl;
+        return 1;
+    }
+    double saveMs = elapsedMs(t0);
+
+    EmergencyPriorityQueue restored(20);
+    TreatmentBoard restoredBoard;
+    EdSnapshotState restoredState;
+    BayAllocator noBays;
+    t0 = steady_clock::now();
+    if (!EdSnapshot::read(path, restored, restoredBoard, restoredState, noBays, error)) {
+        cout << "restore failed: " << error << endl;
+        return 1;
+    }
+    double restoreMs = elapsedMs(t0);
+
+    t0 = steady_clock::now();
+    SlaTimingWheel wheel;
+    wheel.reserve((size_t)restored.getSize());
+    for (int i = 0; i < restored.getSize(); i++) {
+        const EmergencyCase& c = restored.caseAt(i);
+        wheel.schedule(c.caseID, c.priorityLevel, c.arrivalTimeRaw + slaSeconds(c.priorityLevel));
+    }
+    double slaMs = elapsedMs(t0);
+
+    // Same drain order, same counters
+    bool ok = restored.getSize() == original.getSize() && wheel.size() == count &&
+              restoredState.nextCaseID == state.nextCaseID;
+    while (ok && !original.isEmpty()) {
+        ok = original.extractMostCritical().caseID == restored.extractMostCritical().caseID;
+    }
+
+    // Flip one byte in the middle; the checksum must catch it
+    bool corruptRejected = false;
+    FILE* file = fopen(path.c_str(), "r+b");
+    if (file != nullptr) {
+        fseek(file, 0, SEEK_END);
+        long middle = ftell(file) / 2;
+        fseek(file, middle, SEEK_SET);
+        int byte = fgetc(file);
+        fseek(file, middle, SEEK_SET);
+        fputc(byte ^ 0x5A, file);
+        fclose(file);
+        EmergencyPriorityQueue scratch(20);
+        corruptRejected = !EdSnapshot::read(path, scratch, restoredBoard, restoredState, noBays, error);
+    }
+    remove(path.c_str());
+    bool baysOk = baysRoundTripOk(path) && waitlistSlaOk(path);
+    bool idsOk = caseIdsCheckedOk(path);
+
+    cout << "Snapshot of " << count << " pending cases (ms)\n";
+    cout << fixed << setprecision(2);
+    cout << left << setw(22) << "save" << right << setw(12) << saveMs << endl;
+    cout << left << setw(22) << "restore" << right << setw(12) << restoreMs << endl;
+    cout << left << setw(22) << "sla re-register" << right << setw(12) << slaMs << endl;
+    cout << left << setw(22) << "restart total" << right << setw(12) << restoreMs + slaMs << endl;
+    cout << "drain order check: " << (ok ? "ok" : "FAILED") << endl;
+    cout << "corruption check:  " << (corruptRejected ? "ok" : "FAILED") << endl;
+    cout << "bay restore check: " << (baysOk ? "ok" : "FAILED") << endl;
+    cout << "case id check:     " << (idsOk ? "ok" : "FAILED") << endl;
+
+    return (ok && corruptRejected && baysOk && idsOk) ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+// ============================================================================
+// TelemetryIngestBench.cpp
+// Ambulance telemetry ingestion through the SPSC ring
+// ----------------------------------------------------------------------------
+// Writes a replay file for a fleet of 10^4 units (90% POS, 10% STATUS
+// lines), then streams it into an AmbulanceQueue with AmbulanceTelemetry:
+//
+//   lossless  → reader waits when the ring is full; full speed end to end.
+//               Afterwards every unit's position and status must equal the
+//               last update written for it.
+//   paced     → reader paced at a fixed rate, drops when the ring is full;
+//               reports drops and the highest queue depth the consumer saw
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/TelemetryIngestBench.cpp Ambulance.cpp -o telemetry_ingest_bench
+// Usage: ./telemetry_ingest_bench [updates=2000000] [replayFile=/tmp/ambulance_telemetry.txt]
+// ============================================================================
+
+#include "../AmbulanceTelemetry.hpp"
+#include <cstdio>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+static const int UNITS = 10000;
+
+struct Expected
+{
+    double x, y;
+    AmbulanceStatus status;
+};
+
+static vector<Expected> writeReplay(const string& fileName, int updates)
+{
+    vector<Expected> last(UNITS);
+    for (int i = 0; i < UNITS; i++)
+    {
+        last[i].x = last[i].y = 0;
+        last[i].status = STATUS_AVAILABLE;
+    }
+
+    FILE* out = fopen(fileName.c_str(), "w");
+    if (out == nullptr)
+        return vector<Expected>();
+    fprintf(out, "# ambulance telemetry replay, %d units\n", UNITS);
+
+    unsigned seed = 4242u;
+    for (int i = 0; i < updates; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int unit = (int)((seed >> 8) % UNITS);
+        if ((seed >> 4) % 10 == 0)
+        {
+            AmbulanceStatus status = (AmbulanceStatus)((seed >> 20) % STATUS_COUNT);
+            fprintf(out, "STATUS AMB%d %s\n", unit, AmbulanceQueue::statusName(status).c_str());
+            last[unit].status = status;
+        }
+        else
+        {
+            // Positions on a 10 m grid so the text round-trips exactly
+            double x = ((seed >> 12) % 60000) / 1000.0;
+            double y = ((seed * 2654435761u >> 12) % 60000) / 1000.0;
+            fprintf(out, "POS AMB%d %.3f %.3f\n", unit, x, y);
+            last[unit].x = x;
+            last[unit].y = y;
+        }
+    }
+    fclose(out);
+    return last;
+}
+
+static void registerFleet(AmbulanceQueue& fleet)
+{
+    for (int i = 0; i < UNITS; i++)
+        fleet.addAmbulance("AMB" + to_string(i), "Driver " + to_string(i));
+}
+
+static double drain(AmbulanceTelemetry& telemetry, AmbulanceQueue& fleet)
+{
+    steady_clock::time_point t0 = steady_clock::now();
+    while (!telemetry.finished())
+    {
+        if (telemetry.applyPending(fleet) == 0)
+            this_thread::yield();
+    }
+    return duration<double>(steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[])
+{
+    int updates = (argc > 1) ? atoi(argv[1]) : 2000000;
+    string fileName = (argc > 2) ? argv[2] : "/tmp/ambulance_telemetry.txt";
+    if (updates <= 0)
+        updates = 2000000;
+
+    vector<Expected> last = writeReplay(fileName, updates);
+    if (last.empty())
+    {
+        cout << "Cannot write replay file: " << fileName << endl;
+        return 1;
+    }
+
+    bool ok = true;
+    cout << "Telemetry ingestion, " << updates << " updates for " << UNITS << " units\n\n";
+    cout << left << setw(22) << "mode" << right << setw(10) << "ring" << setw(14) << "updates/s"
+         << setw(12) << "dropped" << setw(12) << "max depth" << setw(10) << "batches" << endl;
+
+    const size_t capacities[] = { 1024, 8192, 65536 };
+    for (size_t c = 0; c < 3; c++)
+    {
+        AmbulanceQueue fleet;
+        registerFleet(fleet);
+        AmbulanceTelemetry telemetry(capacities[c], 256, false);
+        telemetry.startReplay(fileName);
+        double seconds = drain(telemetry, fleet);
+        telemetry.stop();
+        TelemetryStats s = telemetry.getStats();
+
+        // Final state must match the last update per unit (registered in
+        // order and never rotated, so rotation position == unit number)
+        bool match = s.applied == updates && s.dropped == 0;
+        int position = 0;
+        fleet.forEachInRotation([&](const Ambulance& a) {
+            const Expected& e = last[position++];
+            match = match && a.status == e.status && (!a.hasPosition || (a.x == e.x && a.y == e.y));
+        });
+        ok = ok && match;
+
+        cout << left << setw(22) << "lossless" << right << setw(10) << s.capacity << setw(14)
+             << (long long)(s.received / seconds) << setw(12) << s.dropped << setw(12) << s.maxDepth
+             << setw(10) << s.batches << endl;
+    }
+
+    const double rates[] = { 100000, 250000 };
+    for (size_t r = 0; r < 2; r++)
+    {
+        for (size_t c = 0; c < 2; c++)
+        {
+            AmbulanceQueue fleet;
+            registerFleet(fleet);
+            AmbulanceTelemetry telemetry(capacities[c], 256, true);
+            int paced = min(updates, (int)rates[r] * 2); // about two seconds of feed
+            telemetry.startReplay(fileName, 1, rates[r]);
+
+            steady_clock::time_point t0 = steady_clock::now();
+            while (telemetry.getStats().received < paced && !telemetry.finished())
+            {
+                if (telemetry.applyPending(fleet) == 0)
+                    this_thread::yield();
+            }
+            telemetry.stop();
+            while (telemetry.applyPending(fleet) > 0)
+            {
+            }
+            double seconds = duration<double>(steady_clock::now() - t0).count();
+            TelemetryStats s = telemetry.getStats();
+            ok = ok && s.applied + s.dropped == s.received;
+
+            string mode = "paced " + to_string((int)(rates[r] / 1000)) + "k/s, drop";
+            cout << left << setw(22) << mode << right << setw(10) << s.capacity << setw(14)
+                 << (long long)(s.received / seconds) << setw(12) << s.dropped << setw(12) << s.maxDepth
+                 << setw(10) << s.batches << endl;
+        }
+    }
+
+    remove(fileName.c_str());
+    cout << "state check: " << (ok ? "ok" : "FAILED") << endl;
+    return ok ? 0 : 1;
+}
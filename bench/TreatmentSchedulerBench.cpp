@@ -0,0 +1,203 @@
+// ============================================================================
+// TreatmentSchedulerBench.cpp
+// Work-stealing TreatmentScheduler vs one central dispatcher
+// ----------------------------------------------------------------------------
+// One producer thread calls cases in bursts and keeps the backlog bounded
+// (about 32 cases per team). Each team thread takes its next case and
+// "treats" it by spinning for a priority-dependent amount of work (~1-8 us).
+//
+//   work-stealing → TreatmentScheduler (critical heap + per-team deques)
+//   central       → one EmergencyPriorityQueue behind one mutex; every team
+//                   locks it for every case
+// Reported: cases/s and call-to-treatment latency percentiles (us) for
+// critical cases and for all cases. Every case must be treated exactly once.
+//
+// Build: g++ -std=gnu++14 -O2 -pthread bench/TreatmentSchedulerBench.cpp -o treatment_scheduler_bench
+// Usage: ./treatment_scheduler_bench [cases=200000]
+// ============================================================================
+
+#include "../TreatmentScheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+class CentralDispatcher {
+private:
+    mutex lock;
+    EmergencyPriorityQueue heap;
+    atomic<int> pending;
+
+public:
+    explicit CentralDispatcher(int) : heap(1024), pending(0) {}
+
+    void submit(const EmergencyCase& c) {
+        lock_guard<mutex> guard(lock);
+        heap.insertEmergencyCase(c);
+        pending.fetch_add(1);
+    }
+
+    bool next(int, EmergencyCase& out) {
+        lock_guard<mutex> guard(lock);
+        if (heap.isEmpty()) return false;
+        out = heap.extractMostCritical();
+        pending.fetch_sub(1);
+        return true;
+    }
+
+    int approximateBacklog() const { return pending.load(memory_order_relaxed); }
+    long long getStealCount() const { return 0; }
+};
+
+static long long nowNs() {
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static unsigned treat(int iterations) {
+    unsigned x = (unsigned)iterations;
+    for (int i = 0; i < iterations; i++) {
+        x = x * 1664525u + 1013904223u;
+    }
+    return x;
+}
+
+struct Workload {
+    vector<int> priority;
+    vector<int> work;              // spin iterations
+};
+
+static Workload makeWorkload(int count) {
+    Workload w;
+    unsigned seed = 31337u;
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int roll = (int)((seed >> 16) % 100);
+        int priority = roll < 15 ? 8 + roll % 3 : (roll < 50 ? 5 + roll % 3 : 1 + roll % 4);
+        w.priority.push_back(priority);
+        w.work.push_back(priority >= 8 ? 8000 : (priority >= 5 ? 4000 : 1500) + (int)(seed % 1000));
+    }
+    return w;
+}
+
+struct RunStats {
+    double casesPerSecond;
+    double criticalP99;
+    double allP50;
+    double allP99;
+    double allP999;
+    long long steals;
+    bool exactlyOnce;
+};
+
+static double percentile(vector<double>& values, double p) {
+    if (values.empty()) return 0;
+    size_t rank = (size_t)(p * (values.size() - 1));
+    nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+template <typename Scheduler>
+static RunStats run(int teams, const Workload& w) {
+    int count = (int)w.priority.size();
+    Scheduler scheduler(teams);
+    vector<long long> calledAt(count), startedAt(count);
+    vector<atomic<int> > treated(count);
+    for (int i = 0; i < count; i++) treated[i].store(0);
+    atomic<int> done(0);
+    atomic<unsigned> sink(0);
+
+    long long t0 = nowNs();
+    vector<thread> workers;
+    for (int t = 0; t < teams; t++) {
+        workers.push_back(thread([&, t]() {
+            EmergencyCase c;
+            unsigned local = 0;
+            while (done.load(memory_order_acquire) < count) {
+                if (!scheduler.next(t, c)) {
+                    this_thread::yield();
+                    continue;
+                }
+                startedAt[c.caseID] = nowNs();
+                local += treat(w.work[c.caseID]);
+                treated[c.caseID].fetch_add(1);
+                done.fetch_add(1, memory_order_release);
+            }
+            sink.fetch_add(local);
+        }));
+    }
+
+    // Producer: bursts of 8 per team, backlog held under 32 per team
+    int burst = 8 * teams;
+    int ceiling = 32 * teams;
+    EmergencyCase c;
+    for (int i = 0; i < count;) {
+        if (scheduler.approximateBacklog() > ceiling - burst) {
+            this_thread::yield();
+            continue;
+        }
+        for (int b = 0; b < burst && i < count; b++, i++) {
+            c.caseID = i;
+            c.priorityLevel = w.priority[i];
+            calledAt[i] = nowNs();
+            scheduler.submit(c);
+        }
+    }
+    for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+    double seconds = (nowNs() - t0) / 1e9;
+
+    RunStats stats;
+    stats.exactlyOnce = true;
+    vector<double> all, critical;
+    for (int i = 0; i < count; i++) {
+        stats.exactlyOnce = stats.exactlyOnce && treated[i].load() == 1;
+        double us = (startedAt[i] - calledAt[i]) / 1000.0;
+        all.push_back(us);
+        if (w.priority[i] >= 8) critical.push_back(us);
+    }
+    stats.casesPerSecond = count / seconds;
+    stats.criticalP99 = percentile(critical, 0.99);
+    stats.allP50 = percentile(all, 0.50);
+    stats.allP99 = percentile(all, 0.99);
+    stats.allP999 = percentile(all, 0.999);
+    stats.steals = scheduler.getStealCount();
+    return stats;
+}
+
+static void printRow(const char* name, int teams, const RunStats& s) {
+    cout << left << setw(15) << name << right << setw(6) << teams
+         << setw(12) << s.casesPerSecond << setw(12) << s.criticalP99
+         << setw(10) << s.allP50 << setw(10) << s.allP99 << setw(11) << s.allP999
+         << setw(10) << s.steals << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int count = (argc > 1) ? atoi(argv[1]) : 200000;
+    if (count <= 0) count = 200000;
+
+    Workload w = makeWorkload(count);
+    const int teamCounts[] = { 1, 2, 4, 8, 16 };
+    bool ok = true;
+
+    cout << "Treatment scheduling of " << count << " cases, hardware threads: "
+         << thread::hardware_concurrency() << "\n";
+    cout << "latency = call to start of treatment (us)\n\n";
+    cout << left << setw(15) << "scheduler" << right << setw(6) << "teams"
+         << setw(12) << "cases/s" << setw(12) << "crit p99" << setw(10) << "p50"
+         << setw(10) << "p99" << setw(11) << "p99.9" << setw(10) << "steals" << endl;
+    cout << fixed << setprecision(1);
+
+    for (size_t i = 0; i < sizeof(teamCounts) / sizeof(teamCounts[0]); i++) {
+        RunStats central = run<CentralDispatcher>(teamCounts[i], w);
+        RunStats stealing = run<TreatmentScheduler>(teamCounts[i], w);
+        ok = ok && central.exactlyOnce && stealing.exactlyOnce;
+        printRow("central", teamCounts[i], central);
+        printRow("work-stealing", teamCounts[i], stealing);
+    }
+    cout << "exactly-once check: " << (ok ? "ok" : "FAILED") << endl;
+
+    return ok ? 0 : 1;
+}
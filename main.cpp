@@ -1,8 +1,17 @@
 #include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
 #include "PatientAdmission.hpp"
 #include "MedicalSupply.hpp"
 #include "EmergencyDepartment.hpp"
 #include "Ambulance.hpp"
+#include "EventBus.hpp"
+#include "AutoDispatch.hpp"
+#include "BatchRunner.hpp"
+#include "Instrumentation.hpp"
 
 using namespace std;
 
@@ -11,12 +20,72 @@ class Emergency;
 class Ambulance;
 class PatientAdmission;
 
-int main() {
+// hospital --batch <script|->: run a command script without menus (BatchRunner.hpp)
+static int runBatch(const char* path, PatientAdmission& pa, MedicalSupply& ms,
+                    EmergencyDepartmentOfficer& ed, AmbulanceQueue& ad, EventBus& bus) {
+    ifstream file;
+    if (strcmp(path, "-") != 0) {
+        file.open(path);
+        if (!file) {
+            cerr << "Cannot open batch script: " << path << endl;
+            return 2;
+        }
+    }
+    ios::sync_with_stdio(false);
+
+    BatchRunner runner(pa.queue(), ms, ed, ad, bus);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    runner.run(file.is_open() ? file : cin, cout);
+    runner.finish(cout);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long commands = runner.getOkCount() + runner.getErrCount();
+    cerr << "# batch: " << commands << " commands, " << runner.getOkCount() << " ok, "
+         << runner.getErrCount() << " err, " << seconds << " s, "
+         << (seconds > 0 ? (long long)(commands / seconds) : 0) << " commands/s" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* batchPath = nullptr;
+    const char* metricsPath = nullptr;
+    int metricsInterval = 10;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--batch") == 0) {
+            batchPath = (i + 1 < argc) ? argv[++i] : "-";
+        } else if (strcmp(argv[i], "--metrics-file") == 0 && i + 1 < argc) {
+            metricsPath = argv[++i];
+        } else if (strcmp(argv[i], "--metrics-interval") == 0 && i + 1 < argc) {
+            metricsInterval = atoi(argv[++i]);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--batch <script|->] [--metrics-file <path>"
+                 << " [--metrics-interval <seconds>]]" << endl;
+            return 2;
+        }
+    }
+    bool batch = batchPath != nullptr;
     PatientAdmission pa;
     MedicalSupply ms;
-    ms.loadSampleData();
+    EventBus bus;
     EmergencyDepartmentOfficer ed("Dr. NG YIK WEI", "TP-070589"); 
     AmbulanceQueue ad;
+    ed.attachEventBus(&bus, 8, !batch);
+    AutoDispatcher dispatcher(bus, ad); // declared last: stops before ad goes away
+
+    // Prometheus text file, rewritten every metricsInterval seconds
+    unique_ptr<MetricsFileWriter> metricsFile;
+    if (metricsPath != nullptr) {
+        if (!instrumentationEnabled()) {
+            cerr << "Note: built without -DHOSPITAL_INSTRUMENTATION, " << metricsPath
+                 << " will only report that instrumentation is off." << endl;
+        }
+        metricsFile.reset(new MetricsFileWriter(metricsPath, metricsInterval));
+    }
+
+    if (batch) {
+        return runBatch(batchPath, pa, ms, ed, ad, bus);
+    }
+    ms.loadSampleData();
 
     int choice;
     do
@@ -29,6 +98,7 @@ int main() {
         cout << "2. Medical Supply Management (Role 2)" << endl;
         cout << "3. Emergency Department Management (Role 3)" << endl;
         cout << "4. Ambulance Dispatch (Role 4)" << endl;
+        cout << "5. Operation Stats" << endl;
         cout << "0. Exit" << endl;
         cout << "Enter choice: ";
         cin >> choice;
@@ -46,6 +116,10 @@ int main() {
             case 4:
                 ad.menu();
                 break;
+            case 5:
+                cout << endl;
+                printOperationStats(cout);
+                break;
             case 0:
                 cout << "Exiting program..." << endl;
                 cout << endl;